@@ -0,0 +1,15 @@
+unsigned int nondet_uint();
+
+int main()
+{
+  unsigned int n = nondet_uint();
+  int x = 0;
+
+  for (unsigned int i = 0; i < n; i++)
+  {
+    x += 2;
+    __ESBMC_assert(x != 8, "x reaches 8");
+  }
+
+  return 0;
+}
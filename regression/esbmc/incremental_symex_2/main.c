@@ -0,0 +1,10 @@
+int main()
+{
+  int x = 0;
+
+  for (int i = 0; i < 5; i++)
+    x += 2;
+
+  __ESBMC_assert(x == 10, "x is 10 after the loop");
+  return 0;
+}
@@ -0,0 +1,28 @@
+#include <assert.h>
+
+int g;
+
+int inc(int x)
+{
+  return x + 1;
+}
+
+int twice(int x)
+{
+  return inc(inc(x));
+}
+
+void set(int v)
+{
+  g = v;
+}
+
+int main()
+{
+  int a = twice(1);
+  set(a);
+  int b = inc(g);
+  assert(b == 4);
+  assert(b == 5);
+  return 0;
+}
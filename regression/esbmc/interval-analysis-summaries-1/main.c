@@ -0,0 +1,18 @@
+#include <assert.h>
+
+int g;
+
+void set(int v)
+{
+  g = v;
+}
+
+int main()
+{
+  set(1);
+  int b = g;
+  set(5);
+  assert(b == 1);
+  assert(g == 5);
+  return 0;
+}
@@ -0,0 +1,11 @@
+#include <assert.h>
+
+int main()
+{
+  int s = 0;
+  for (int i = 0; i < 10; i++)
+    for (int j = 0; j < 10; j++)
+      s++;
+  assert(s >= 0);
+  return 0;
+}
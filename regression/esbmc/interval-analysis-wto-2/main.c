@@ -0,0 +1,14 @@
+#include <assert.h>
+
+void f(int n)
+{
+  assert(n >= 0);
+  if (n < 1000000)
+    f(n + 1);
+}
+
+int main()
+{
+  f(0);
+  return 0;
+}
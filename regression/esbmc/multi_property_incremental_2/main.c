@@ -0,0 +1,13 @@
+#include <assert.h>
+extern int __VERIFIER_nondet_int(void);
+
+int main()
+{
+  int x = __VERIFIER_nondet_int();
+  __ESBMC_assume(x > 0 && x < 10);
+  int y = x * 2;
+  assert(y > x);
+  assert(y < 20);
+  assert(y % 2 == 0);
+  return 0;
+}
@@ -0,0 +1,6 @@
+extern int counter;
+
+int h()
+{
+  return counter + 1;
+}
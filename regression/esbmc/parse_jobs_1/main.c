@@ -0,0 +1,19 @@
+#include <assert.h>
+
+static int f()
+{
+  return 1;
+}
+
+int g();
+int h();
+
+int counter;
+
+int main()
+{
+  assert(f() == 1);
+  assert(g() == 2);
+  assert(counter == 1);
+  assert(h() == 3);
+}
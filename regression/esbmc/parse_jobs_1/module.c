@@ -0,0 +1,11 @@
+static int f()
+{
+  return 2;
+}
+
+int counter = 1;
+
+int g()
+{
+  return f();
+}
@@ -0,0 +1,6 @@
+#include <stdlib.h>
+
+static int twice(int x)
+{
+  return 2 * x;
+}
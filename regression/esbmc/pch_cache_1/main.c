@@ -0,0 +1,13 @@
+/* The leading includes go into the precompiled prelude */
+#include <assert.h>
+#include <stdlib.h>
+
+#include "helper.h"
+
+int main()
+{
+  div_t d = div(7, 2);
+  assert(d.quot == 3);
+  assert(twice(d.rem) == 2);
+  assert(__VERIFIER_nondet_int() != 4);
+}
@@ -0,0 +1,17 @@
+#include <assert.h>
+
+static int f()
+{
+  return 1;
+}
+
+int g();
+
+int counter;
+
+int main()
+{
+  assert(f() == 1);
+  assert(g() == 2);
+  assert(counter == 1);
+}
@@ -0,0 +1,14 @@
+#include <assert.h>
+
+float nondet_float();
+
+int main()
+{
+  float x = nondet_float();
+  __ESBMC_assume(x >= 1.0f && x <= 2.0f);
+  float y = x * x;
+  float z = y / x;
+  assert(y >= 1.0f);
+  assert(z - x <= 0.5f);
+  return 0;
+}
@@ -0,0 +1,12 @@
+#include <assert.h>
+
+float nondet_float();
+
+int main()
+{
+  float x = nondet_float();
+  __ESBMC_assume(x >= 1.0f && x <= 2.0f);
+  float y = x * 3.0f + 1.0f;
+  assert(y != 7.0f);
+  return 0;
+}
@@ -0,0 +1,18 @@
+#include <assert.h>
+
+unsigned int nondet_uint();
+
+int main()
+{
+  unsigned int n = nondet_uint();
+  unsigned int i = 0, x = 0;
+
+  while (i < n)
+  {
+    x += 2;
+    i++;
+  }
+
+  assert(x == 2 * i);
+  return 0;
+}
@@ -0,0 +1,17 @@
+#include <assert.h>
+
+unsigned int nondet_uint();
+
+int main()
+{
+  unsigned int n = nondet_uint();
+  unsigned int x = 0;
+
+  for (unsigned int i = 0; i < n; i++)
+  {
+    x += 3;
+    assert(x != 12);
+  }
+
+  return 0;
+}
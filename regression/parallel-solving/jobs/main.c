@@ -0,0 +1,14 @@
+#include <assert.h>
+extern int __VERIFIER_nondet_int(void);
+
+int main()
+{
+  int a = __VERIFIER_nondet_int();
+  int b = a;
+  assert(a == b);
+  assert(a + 1 == b + 1);
+  assert(a - b == 0);
+  assert(b - a == 0);
+  assert(a * 2 == b * 2);
+  return 0;
+}
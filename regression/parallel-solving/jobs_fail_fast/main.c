@@ -0,0 +1,12 @@
+#include <assert.h>
+extern int __VERIFIER_nondet_int(void);
+
+int main()
+{
+  int a = __VERIFIER_nondet_int();
+  assert(a != 1);
+  assert(a != 2);
+  assert(a != 3);
+  assert(a != 4);
+  return 0;
+}
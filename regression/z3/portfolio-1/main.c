@@ -0,0 +1,12 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  int y = x * 3;
+  if (x > 10 && x < 20)
+    assert(y != 42);
+  return 0;
+}
@@ -0,0 +1,193 @@
+#!/usr/bin/env python3
+"""Builds a rule table for esbmc --auto-solver-rules from benchmark runs.
+
+Every benchmark is run once to read the features of its formula and then
+once per solver. The measurements are kept in a CSV file, so that the table
+can be rebuilt offline with different settings:
+
+  calibrate.py --esbmc build/src/esbmc/esbmc --solvers z3,bitwuzla,yices \\
+      --timeout 60 --csv runs.csv benchmarks/*.c > rules.txt
+  calibrate.py --from-csv runs.csv > rules.txt
+
+Formulas with the same features get the solver with the best PAR-2 score
+(timeouts count twice the timeout). Where the best solver changes with the
+size of the formula, the group is split on its number of nodes.
+"""
+
+import argparse
+import csv
+import re
+import subprocess
+import sys
+import time
+from collections import defaultdict
+
+FEATURES = {
+    "NON LINEAR": "nonlinear",
+    "NON INTEGER NUMERAL": "non-integer-numeral",
+    "BITWISE OPERATIONS": "bitwise",
+    "OVERFLOW ASSERTIONS": "overflow",
+    "ARRAY": "array",
+    "STRUCTS": "struct",
+    "FLOATING POINT": "float",
+}
+
+METRICS = re.compile(r"SSA: (\d+) steps, (\d+) nodes, depth (\d+)")
+
+# A split has to improve the score of its group by this much to be kept
+MIN_SPLIT_GAIN = 0.05
+
+
+class ESBMC:
+    """Wrapper for ESBMC"""
+
+    def __init__(self, esbmc: str, esbmc_args: str):
+        self.esbmc = esbmc
+        self.esbmc_args = esbmc_args.split()
+
+    def features(self, benchmark: str):
+        """The features and metrics of the benchmark's formula"""
+        cmd = [self.esbmc, benchmark, *self.esbmc_args,
+               "--ssa-features-dump", "--program-only"]
+        out = subprocess.run(cmd, stdout=subprocess.PIPE,
+                             stderr=subprocess.STDOUT, text=True).stdout
+        features = sorted(name for text, name in FEATURES.items()
+                          if f"SSA: Contains {text}\n" in out)
+        # Only the last formula counts, e.g. for the largest bound
+        metrics = METRICS.findall(out)
+        steps, nodes, depth = map(int, metrics[-1]) if metrics else (0, 0, 0)
+        return features, steps, nodes, depth
+
+    def solve(self, benchmark: str, solver: str, timeout: float):
+        """Seconds taken by `solver`, None on timeout or error"""
+        cmd = [self.esbmc, benchmark, *self.esbmc_args, f"--{solver}"]
+        start = time.monotonic()
+        try:
+            ps = subprocess.run(cmd, stdout=subprocess.PIPE,
+                                stderr=subprocess.STDOUT, text=True,
+                                timeout=timeout)
+        except subprocess.TimeoutExpired:
+            return None
+        if "VERIFICATION SUCCESSFUL" not in ps.stdout and \
+                "VERIFICATION FAILED" not in ps.stdout:
+            return None
+        return time.monotonic() - start
+
+
+def measure(args):
+    """Rows of benchmark, features, steps, nodes, depth, solver, time"""
+    esbmc = ESBMC(args.esbmc, args.esbmc_args)
+    rows = []
+    for benchmark in args.benchmarks:
+        features, steps, nodes, depth = esbmc.features(benchmark)
+        for solver in args.solvers.split(","):
+            seconds = esbmc.solve(benchmark, solver, args.timeout)
+            print(f"{benchmark} {solver}: "
+                  f"{'timeout' if seconds is None else f'{seconds:.2f}s'}",
+                  file=sys.stderr)
+            rows.append({"benchmark": benchmark,
+                         "features": " ".join(features),
+                         "steps": steps, "nodes": nodes, "depth": depth,
+                         "solver": solver,
+                         "time": "" if seconds is None else f"{seconds:.3f}",
+                         "timeout": args.timeout})
+    return rows
+
+
+def score(runs, solver):
+    """PAR-2 score of `solver` over `runs`, a list of per-benchmark dicts"""
+    total = 0.0
+    for run in runs:
+        seconds = run["times"].get(solver)
+        total += 2 * run["timeout"] if seconds is None else seconds
+    return total
+
+
+def best(runs, solvers):
+    return min(solvers, key=lambda s: score(runs, s))
+
+
+def derive(rows):
+    """The rule table for the measurements in `rows`"""
+    benchmarks = {}
+    solvers = []
+    for row in rows:
+        if row["solver"] not in solvers:
+            solvers.append(row["solver"])
+        run = benchmarks.setdefault(row["benchmark"], {
+            "features": tuple(row["features"].split()),
+            "nodes": int(row["nodes"]),
+            "timeout": float(row["timeout"]),
+            "times": {}})
+        if row["time"]:
+            run["times"][row["solver"]] = float(row["time"])
+
+    groups = defaultdict(list)
+    for run in benchmarks.values():
+        groups[run["features"]].append(run)
+
+    names = sorted(FEATURES.values())
+    lines = [f"# Calibrated on {len(benchmarks)} benchmark(s) with "
+             f"{', '.join(solvers)}"]
+    # Larger groups first, they are worth more
+    for features, runs in sorted(groups.items(), key=lambda g: -len(g[1])):
+        conditions = [n if n in features else "!" + n for n in names]
+        default = best(runs, solvers)
+        cost = score(runs, default)
+
+        # The split on the number of nodes that gains the most
+        split = None
+        for threshold in sorted({r["nodes"] for r in runs})[1:]:
+            large = [r for r in runs if r["nodes"] >= threshold]
+            small = [r for r in runs if r["nodes"] < threshold]
+            large_best, small_best = best(large, solvers), best(small, solvers)
+            split_cost = score(large, large_best) + score(small, small_best)
+            if split_cost < cost * (1 - MIN_SPLIT_GAIN) and \
+                    (split is None or split_cost < split[0]):
+                split = (split_cost, threshold, large_best, small_best)
+
+        lines.append(f"# {len(runs)} benchmark(s)")
+        if split is not None:
+            _, threshold, large_best, default = split
+            lines.append(f"{', '.join(conditions)}, nodes >= {threshold} : "
+                         f"solver={large_best}")
+        lines.append(f"{', '.join(conditions)} : solver={default}")
+
+    # Unseen combinations of features, and solvers that aren't built in
+    for solver in sorted(solvers,
+                         key=lambda s: score(list(benchmarks.values()), s)):
+        lines.append(f"* : solver={solver}")
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("benchmarks", nargs="*")
+    parser.add_argument("--esbmc", default="esbmc")
+    parser.add_argument("--esbmc-args", default="",
+                        help="options for every run, e.g. the bound")
+    parser.add_argument("--solvers", default="boolector,bitwuzla,z3,yices")
+    parser.add_argument("--timeout", type=float, default=60)
+    parser.add_argument("--csv", help="keep the measurements in this file")
+    parser.add_argument("--from-csv",
+                        help="build the table from earlier measurements")
+    args = parser.parse_args()
+
+    if args.from_csv:
+        with open(args.from_csv, newline="") as f:
+            rows = list(csv.DictReader(f))
+    else:
+        rows = measure(args)
+        if args.csv:
+            with open(args.csv, "w", newline="") as f:
+                writer = csv.DictWriter(f, fieldnames=list(rows[0]))
+                writer.writeheader()
+                writer.writerows(rows)
+
+    sys.stdout.write(derive(rows))
+
+
+if __name__ == "__main__":
+    main()
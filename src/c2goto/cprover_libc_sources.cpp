@@ -3,6 +3,7 @@
 #include <boost/filesystem/operations.hpp>
 #include <c2goto/cprover_library.h>
 #include <fstream>
+#include <util/crypto_hash.h>
 #include <util/language.h>
 #include <util/filesystem.h>
 
@@ -43,28 +44,55 @@ static class
 #undef ESBMC_FLAIL
   }
 
-public:
-  const std::string &header_dir()
+  static void write_headers(const std::string &headers)
   {
-    if (headers == "")
-    {
-      using namespace boost::filesystem;
-      headers = base_path() + "/headers";
-      create_directory(headers);
-      create_directory(headers + "/__esbmc");
-      create_directory(headers + "/bits");
-      create_directory(headers + "/sys");
-      create_directory(headers + "/sys/_types");
-      create_directory(headers + "/sys/_pthread");
-      create_directory(headers + "/ubuntu20.04");
-      create_directory(headers + "/ubuntu20.04/kernel_5.15.0-76");
-      create_directory(headers + "/ubuntu20.04/kernel_5.15.0-76/include");
-      create_directory(headers + "/ubuntu20.04/kernel_5.15.0-76/include/linux");
-      create_directory(headers + "/ubuntu20.04/kernel_5.15.0-76/include/asm");
+    using namespace boost::filesystem;
+    create_directory(headers + "/__esbmc");
+    create_directory(headers + "/bits");
+    create_directory(headers + "/sys");
+    create_directory(headers + "/sys/_types");
+    create_directory(headers + "/sys/_pthread");
+    create_directory(headers + "/ubuntu20.04");
+    create_directory(headers + "/ubuntu20.04/kernel_5.15.0-76");
+    create_directory(headers + "/ubuntu20.04/kernel_5.15.0-76/include");
+    create_directory(headers + "/ubuntu20.04/kernel_5.15.0-76/include/linux");
+    create_directory(headers + "/ubuntu20.04/kernel_5.15.0-76/include/asm");
 #define ESBMC_FLAIL(body, size, ...)                                           \
   std::ofstream(headers + "/" #__VA_ARGS__).write(body, size);
 #include <headers/libc_hdr.h>
 #undef ESBMC_FLAIL
+  }
+
+  static std::string headers_hash()
+  {
+    crypto_hash hash;
+#define ESBMC_FLAIL(body, size, ...)                                           \
+  hash.ingest(#__VA_ARGS__, sizeof(#__VA_ARGS__));                             \
+  hash.ingest(&size, sizeof(size));                                            \
+  hash.ingest(body, size);
+#include <headers/libc_hdr.h>
+#undef ESBMC_FLAIL
+    hash.fin();
+    return hash.to_string();
+  }
+
+public:
+  const std::string &header_dir()
+  {
+    if (headers == "")
+    {
+      /* Precompiled headers refer to the headers by path, so with
+       * --pch-cache they are kept next to them instead */
+      std::string shared = config.options.get_option("pch-cache");
+      if (!shared.empty())
+        headers = file_operations::create_shared_dir(
+          shared, "libc-headers-" + headers_hash(), write_headers);
+      else
+      {
+        headers = base_path() + "/headers";
+        boost::filesystem::create_directory(headers);
+        write_headers(headers);
+      }
     }
     return headers;
   }
@@ -1,13 +1,15 @@
 #include <ac_config.h>
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <c2goto/cprover_library.h>
 #include <cstdlib>
+#include <deque>
 #include <fstream>
-#include <goto-programs/goto_binary_reader.h>
-#include <goto-programs/goto_functions.h>
+#include <goto-programs/goto_binary_index.h>
 #include <util/c_link.h>
 #include <util/config.h>
 #include <util/language.h>
+#include <unordered_set>
 
 extern "C"
 {
@@ -136,17 +138,12 @@ const static std::vector<std::string> python_c_models = {
 
 } // namespace
 
-static void generate_symbol_deps(
-  irep_idt name,
-  irept irep,
-  std::multimap<irep_idt, irep_idt> &deps)
+/* Collects the ids of all symbols `irep` refers to. */
+static void generate_symbol_deps(const irept &irep, std::vector<irep_idt> &deps)
 {
-  std::pair<irep_idt, irep_idt> type;
-
   if (irep.id() == "symbol")
   {
-    type = std::pair<irep_idt, irep_idt>(name, irep.identifier());
-    deps.insert(type);
+    deps.push_back(irep.identifier());
     return;
   }
 
@@ -154,71 +151,32 @@ static void generate_symbol_deps(
   {
     if (irep_it->id() == "symbol")
     {
-      type = std::pair<irep_idt, irep_idt>(name, irep_it->identifier());
-      deps.insert(type);
-      generate_symbol_deps(name, *irep_it, deps);
+      deps.push_back(irep_it->identifier());
+      generate_symbol_deps(*irep_it, deps);
     }
     else if (irep_it->id() == "argument")
-    {
-      type = std::pair<irep_idt, irep_idt>(name, irep_it->cmt_identifier());
-      deps.insert(type);
-    }
+      deps.push_back(irep_it->cmt_identifier());
     else
-    {
-      generate_symbol_deps(name, *irep_it, deps);
-    }
+      generate_symbol_deps(*irep_it, deps);
   }
 
   forall_named_irep (irep_it, irep.get_named_sub())
   {
     if (irep_it->second.id() == "symbol")
-    {
-      type = std::pair<irep_idt, irep_idt>(name, irep_it->second.identifier());
-      deps.insert(type);
-    }
+      deps.push_back(irep_it->second.identifier());
     else if (irep_it->second.id() == "argument")
-    {
-      type =
-        std::pair<irep_idt, irep_idt>(name, irep_it->second.cmt_identifier());
-      deps.insert(type);
-    }
+      deps.push_back(irep_it->second.cmt_identifier());
     else
-    {
-      generate_symbol_deps(name, irep_it->second, deps);
-    }
+      generate_symbol_deps(irep_it->second, deps);
   }
 }
 
-static void ingest_symbol(
-  irep_idt name,
-  std::multimap<irep_idt, irep_idt> &deps,
-  std::list<irep_idt> &to_include)
-{
-  std::pair<
-    std::multimap<irep_idt, irep_idt>::const_iterator,
-    std::multimap<irep_idt, irep_idt>::const_iterator>
-    range;
-  std::multimap<irep_idt, irep_idt>::const_iterator it;
-
-  range = deps.equal_range(name);
-  if (range.first == range.second)
-    return;
-
-  for (it = range.first; it != range.second; it++)
-    to_include.push_back(it->second);
-
-  deps.erase(name);
-}
-
 void add_cprover_library(contextt &context, const languaget *language)
 {
   if (config.ansi_c.lib == configt::ansi_ct::libt::LIB_NONE)
     return;
 
-  contextt new_ctx, store_ctx;
-  goto_functionst goto_functions;
-  std::multimap<irep_idt, irep_idt> symbol_deps;
-  std::list<irep_idt> to_include;
+  contextt store_ctx;
   const buffer *clib;
 
   switch (config.ansi_c.word_size)
@@ -246,62 +204,74 @@ void add_cprover_library(contextt &context, const languaget *language)
     abort();
   }
 
-  goto_binary_reader goto_reader;
-
-  if (language && language->id() == "python")
-    goto_reader.set_functions_to_read(python_c_models);
-
-  if (goto_reader.read_goto_binary_array(
-        clib->start, clib->size, new_ctx, goto_functions))
+  /* Only the index of the library is parsed here; symbols are deserialized
+   * once they turn out to be needed by the program. */
+  goto_binary_indext library;
+  if (library.load(clib->start, clib->size))
     abort();
 
-  new_ctx.foreach_operand([&symbol_deps](const symbolt &s) {
-    generate_symbol_deps(s.id, s.value, symbol_deps);
-    generate_symbol_deps(s.id, s.type, symbol_deps);
-  });
+  bool python = language && language->id() == "python";
+
+  auto available = [&library, python](const irep_idt &id) {
+    const goto_binary_indext::entryt *e = library.find_symbol(id);
+    if (e && python)
+    {
+      auto it = std::find(
+        python_c_models.begin(),
+        python_c_models.end(),
+        e->function.as_string());
+      if (it == python_c_models.end())
+        return (const goto_binary_indext::entryt *)nullptr;
+    }
+    return e;
+  };
 
   // Add two hacks; we might use either pthread_mutex_lock or the checked
   // variant; so if one version is used, pull in the other too.
-  std::pair<irep_idt, irep_idt> lockcheck(
-    dstring("pthread_mutex_lock"), dstring("pthread_mutex_lock_check"));
-  symbol_deps.insert(lockcheck);
+  const std::multimap<irep_idt, irep_idt> extra_deps = {
+    {"pthread_mutex_lock", "pthread_mutex_lock_check"},
+    {"pthread_cond_wait", "pthread_cond_wait_check"},
+    {"pthread_join", "pthread_join_noswitch"}};
+
+  /* Start from the library symbols the program declares but doesn't define
+   * (or, for Python, all of its C models), then repeatedly pull in the
+   * library symbols those use until no new ones are found. */
+  std::deque<irep_idt> to_include;
+  for (const goto_binary_indext::entryt &e : library.symbols())
+  {
+    const symbolt *symbol = context.find_symbol(e.name);
+    if (python)
+    {
+      if (available(e.name))
+        to_include.push_back(e.name);
+    }
+    else if (symbol != nullptr && symbol->value.is_nil())
+      to_include.push_back(e.name);
+  }
 
-  std::pair<irep_idt, irep_idt> condcheck(
-    dstring("pthread_cond_wait"), dstring("pthread_cond_wait_check"));
-  symbol_deps.insert(condcheck);
+  std::unordered_set<irep_idt, irep_id_hash> ingested;
+  std::vector<irep_idt> deps;
+  while (!to_include.empty())
+  {
+    irep_idt name = to_include.front();
+    to_include.pop_front();
 
-  std::pair<irep_idt, irep_idt> joincheck(
-    dstring("pthread_join"), dstring("pthread_join_noswitch"));
-  symbol_deps.insert(joincheck);
+    const goto_binary_indext::entryt *e = available(name);
+    if (e == nullptr || !ingested.insert(name).second)
+      continue;
 
-  /* The code just pulled into store_ctx might use other symbols in the C
-   * library. So, repeatedly search for new C library symbols that we use but
-   * haven't pulled in, then pull them in. We finish when we've made a pass
-   * that adds no new symbols. */
+    symbolt s;
+    library.read_symbol(*e, s);
 
-  new_ctx.foreach_operand(
-    [&context, &store_ctx, &symbol_deps, &to_include, &language](
-      const symbolt &s) {
-      const symbolt *symbol = context.find_symbol(s.id);
-      if (
-        (language && language->id() == "python") ||
-        (symbol != nullptr && symbol->value.is_nil()))
-      {
-        store_ctx.add(s);
-        ingest_symbol(s.id, symbol_deps, to_include);
-      }
-    });
+    deps.clear();
+    generate_symbol_deps(s.value, deps);
+    generate_symbol_deps(s.type, deps);
+    auto range = extra_deps.equal_range(name);
+    for (auto it = range.first; it != range.second; ++it)
+      deps.push_back(it->second);
+    to_include.insert(to_include.end(), deps.begin(), deps.end());
 
-  for (std::list<irep_idt>::const_iterator nameit = to_include.begin();
-       nameit != to_include.end();
-       nameit++)
-  {
-    symbolt *s = new_ctx.find_symbol(*nameit);
-    if (s != nullptr)
-    {
-      store_ctx.add(*s);
-      ingest_symbol(*nameit, symbol_deps, to_include);
-    }
+    store_ctx.move(s);
   }
 
   if (c_link(context, store_ctx, "<built-in-library>"))
@@ -20,6 +20,7 @@ CC_DIAGNOSTIC_IGNORE_LLVM_CHECKS()
 #else
 #  include <llvm/TargetParser/Host.h>
 #endif
+#include <llvm/Support/FileSystem.h>
 #include <llvm/Support/Path.h>
 CC_DIAGNOSTIC_POP()
 
@@ -53,25 +54,36 @@ static clang::driver::Driver *newDriver(
   return CompilerDriver;
 }
 
-std::unique_ptr<clang::ASTUnit> buildASTs(
-  const std::string &intrinsics,
-  const std::vector<std::string> &compiler_args)
+namespace
+{
+/// Everything needed to run the clang frontend on a command line
+struct ToolSetup
+{
+  llvm::IntrusiveRefCntPtr<clang::FileManager> Files;
+  llvm::IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> InMemoryFileSystem;
+  llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> DiagOpts;
+  std::unique_ptr<clang::TextDiagnosticPrinter> DiagnosticPrinter;
+  clang::DiagnosticsEngine *Diagnostics;
+  std::shared_ptr<clang::CompilerInvocation> Invocation;
+};
+} // namespace
+
+static void
+newToolSetup(const std::vector<std::string> &compiler_args, ToolSetup &Setup)
 {
   // Create virtual file system to add clang's headers
   llvm::IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> OverlayFileSystem(
     new llvm::vfs::OverlayFileSystem(llvm::vfs::getRealFileSystem()));
 
-  llvm::IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> InMemoryFileSystem(
-    new llvm::vfs::InMemoryFileSystem);
-  OverlayFileSystem->pushOverlay(InMemoryFileSystem);
+  Setup.InMemoryFileSystem = new llvm::vfs::InMemoryFileSystem;
+  OverlayFileSystem->pushOverlay(Setup.InMemoryFileSystem);
 
-  llvm::IntrusiveRefCntPtr<clang::FileManager> Files(
-    new clang::FileManager(clang::FileSystemOptions(), OverlayFileSystem));
+  Setup.Files =
+    new clang::FileManager(clang::FileSystemOptions(), OverlayFileSystem);
 
   // Create everything needed to create a CompilerInvocation,
   // copied from ToolInvocation::run
-  llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> DiagOpts =
-    new clang::DiagnosticOptions();
+  Setup.DiagOpts = new clang::DiagnosticOptions();
 
   std::vector<const char *> Argv;
   for (const std::string &Str : compiler_args)
@@ -85,18 +97,19 @@ std::unique_ptr<clang::ASTUnit> buildASTs(
       MissingArgIndex,
       MissingArgCount);
 
-  clang::ParseDiagnosticArgs(*DiagOpts, ParsedArgs);
+  clang::ParseDiagnosticArgs(*Setup.DiagOpts, ParsedArgs);
 
-  clang::TextDiagnosticPrinter DiagnosticPrinter(llvm::errs(), &*DiagOpts);
+  Setup.DiagnosticPrinter = std::make_unique<clang::TextDiagnosticPrinter>(
+    llvm::errs(), &*Setup.DiagOpts);
 
-  clang::DiagnosticsEngine *Diagnostics = new clang::DiagnosticsEngine(
+  Setup.Diagnostics = new clang::DiagnosticsEngine(
     llvm::IntrusiveRefCntPtr<clang::DiagnosticIDs>(new clang::DiagnosticIDs()),
-    &*DiagOpts,
-    &DiagnosticPrinter,
+    &*Setup.DiagOpts,
+    Setup.DiagnosticPrinter.get(),
     false);
 
-  const std::unique_ptr<clang::driver::Driver> Driver(
-    newDriver(Diagnostics, BinaryName, &Files->getVirtualFileSystem()));
+  const std::unique_ptr<clang::driver::Driver> Driver(newDriver(
+    Setup.Diagnostics, BinaryName, &Setup.Files->getVirtualFileSystem()));
 
   // Since the input might only be virtual, don't check whether it exists.
   Driver->setCheckInputsExist(false);
@@ -108,26 +121,51 @@ std::unique_ptr<clang::ASTUnit> buildASTs(
 
   const llvm::opt::ArgStringList *const CC1Args = &Jobs.begin()->getArguments();
 
-  std::shared_ptr<clang::CompilerInvocation> Invocation(
-    clang::tooling::newInvocation(Diagnostics, *CC1Args, BinaryName));
+  Setup.Invocation.reset(
+    clang::tooling::newInvocation(Setup.Diagnostics, *CC1Args, BinaryName));
 
   // Show the invocation, with -v.
-  if (Invocation->getHeaderSearchOpts().Verbose)
+  if (Setup.Invocation->getHeaderSearchOpts().Verbose)
   {
     llvm::errs() << "clang Invocation:\n";
     Compilation->getJobs().Print(llvm::errs(), "\n", true);
     llvm::errs() << "\n";
   }
+}
+
+std::unique_ptr<clang::ASTUnit> buildASTs(
+  const std::string &intrinsics,
+  const std::vector<std::string> &compiler_args,
+  const std::string &pch)
+{
+  ToolSetup Setup;
+  newToolSetup(compiler_args, Setup);
 
-  // Create our custom action
-  auto action = new esbmc_action(std::move(intrinsics));
+  // Create our custom action, the intrinsics are part of the PCH if there is
+  // one
+  auto action = new esbmc_action(pch.empty() ? std::string(intrinsics) : "");
+
+  if (!pch.empty())
+  {
+    // The PCH comes from our cache, which checks its inputs itself; they
+    // may even be gone, as the PCH embeds them
+    clang::PreprocessorOptions &PPOpts =
+      Setup.Invocation->getPreprocessorOpts();
+    PPOpts.ImplicitPCHInclude = pch;
+#if CLANG_VERSION_MAJOR < 13
+    PPOpts.DisablePCHValidation = true;
+#else
+    PPOpts.DisablePCHOrModuleValidation =
+      clang::DisableValidationForModuleKind::All;
+#endif
+  }
 
   // Create ASTUnit
   std::unique_ptr<clang::ASTUnit> unit(
     clang::ASTUnit::LoadFromCompilerInvocationAction(
-      std::move(Invocation),
+      std::move(Setup.Invocation),
       std::make_shared<clang::PCHContainerOperations>(),
-      Diagnostics,
+      Setup.Diagnostics,
       action));
   assert(unit);
 
@@ -138,6 +176,70 @@ std::unique_ptr<clang::ASTUnit> buildASTs(
   return unit;
 }
 
+// The source manager's files are keyed by FileEntry pointers in older clang
+// versions and by FileEntryRef in newer ones
+template <typename T>
+static auto file_name(const T *File) -> decltype(File->getName().str())
+{
+  return File->getName().str();
+}
+
+template <typename T>
+static auto file_name(const T &File) -> decltype(File.getName().str())
+{
+  return File.getName().str();
+}
+
+static std::vector<std::string> inputFiles(const clang::SourceManager &SM)
+{
+  std::vector<std::string> Files;
+  for (auto It = SM.fileinfo_begin(); It != SM.fileinfo_end(); ++It)
+    Files.push_back(file_name(It->first));
+  return Files;
+}
+
+bool buildPCH(
+  const std::string &prelude,
+  const std::vector<std::string> &compiler_args,
+  const std::string &output,
+  std::vector<std::string> &inputs)
+{
+  // The prelude only exists in memory, next to the PCH
+  llvm::SmallString<128> PreludePath(output + ".h");
+  llvm::sys::fs::make_absolute(PreludePath);
+
+  std::vector<std::string> args = compiler_args;
+  args.push_back(PreludePath.str().str());
+
+  ToolSetup Setup;
+  newToolSetup(args, Setup);
+  Setup.InMemoryFileSystem->addFile(
+    PreludePath, 0, llvm::MemoryBuffer::getMemBufferCopy(prelude));
+
+  clang::FrontendOptions &FrontendOpts = Setup.Invocation->getFrontendOpts();
+  assert(FrontendOpts.Inputs.size() == 1);
+  FrontendOpts.Inputs[0] = clang::FrontendInputFile(
+    PreludePath, FrontendOpts.Inputs[0].getKind().getHeader());
+  FrontendOpts.OutputFile = output;
+
+  clang::CompilerInstance CI(std::make_shared<clang::PCHContainerOperations>());
+  CI.setInvocation(std::move(Setup.Invocation));
+  CI.setDiagnostics(Setup.Diagnostics);
+  CI.setFileManager(Setup.Files.get());
+  CI.createSourceManager(*Setup.Files);
+
+  // Keep the contents of every file read in the PCH, so that it can be used
+  // once our bundled headers are extracted somewhere else
+  CI.getSourceManager().setAllFilesAreTransient(true);
+
+  clang::GeneratePCHAction Action;
+  if (!CI.ExecuteAction(Action) || CI.getDiagnostics().hasErrorOccurred())
+    return true;
+
+  inputs = inputFiles(CI.getSourceManager());
+  return false;
+}
+
 void mergeASTs(
   const std::unique_ptr<clang::ASTUnit> &FromUnit,
   std::unique_ptr<clang::ASTUnit> &ToUnit)
@@ -167,3 +269,8 @@ void mergeASTs(
     }
   }
 }
+
+std::vector<std::string> getInputFiles(const clang::ASTUnit &Unit)
+{
+  return inputFiles(Unit.getSourceManager());
+}
@@ -2,6 +2,7 @@
 #define CLANG_C_FRONTEND_AST_BUILD_AST_H_
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -14,12 +15,27 @@ namespace clang
 class ASTUnit;
 } // namespace clang
 
+/* Parses the file given last in `compiler_args`. If `pch` is not empty, it
+ * is loaded first and must hold `intrinsics`, see buildPCH. */
 std::unique_ptr<clang::ASTUnit> buildASTs(
   const std::string &intrinsics,
-  const std::vector<std::string> &compiler_args);
+  const std::vector<std::string> &compiler_args,
+  const std::string &pch = "");
+
+/* Precompiles the header `prelude` for use with `compiler_args`, which don't
+ * name an input file, into `output`. The files it read are added to
+ * `inputs`. Returns true on error. */
+bool buildPCH(
+  const std::string &prelude,
+  const std::vector<std::string> &compiler_args,
+  const std::string &output,
+  std::vector<std::string> &inputs);
 
 void mergeASTs(
   const std::unique_ptr<clang::ASTUnit> &FromUnit,
   std::unique_ptr<clang::ASTUnit> &ToUnit);
 
+/// Paths of the files read to build `Unit`, including the headers
+std::vector<std::string> getInputFiles(const clang::ASTUnit &Unit);
+
 #endif /* CLANG_C_FRONTEND_AST_BUILD_AST_H_ */
@@ -13,8 +13,11 @@ CC_DIAGNOSTIC_POP()
 #include <clang-c-frontend/clang_c_language.h>
 #include <clang-c-frontend/clang_c_main.h>
 #include <util/c_expr2string.h>
+#include <fstream>
 #include <sstream>
 #include <util/c_link.h>
+#include <util/prefix.h>
+#include <util/thread_pool.h>
 
 #include <util/filesystem.h>
 
@@ -281,44 +284,282 @@ void clang_c_languaget::force_file_type(std::vector<std::string> &compiler_args)
 
 bool clang_c_languaget::parse(const std::string &path)
 {
-  // preprocessing
+  return parse_files({path}, 1);
+}
 
-  std::ostringstream o_preprocessed;
-  if (preprocess(path, o_preprocessed))
-    return true;
+bool clang_c_languaget::parse_files(
+  const std::vector<std::string> &paths,
+  unsigned jobs)
+{
+  // Get intrinsics
+  std::string intrinsics = internal_additions();
+
+  std::string cache_dir = config.options.get_option("tu-cache");
+  if (id() == "c" && !cache_dir.empty() && !tu_cache)
+    tu_cache = std::make_unique<tu_cachet>(cache_dir);
+
+  std::string pch_dir = config.options.get_option("pch-cache");
+  if (id() == "c" && !pch_dir.empty() && !pch_cache)
+    pch_cache = std::make_unique<tu_cachet>(pch_dir);
+
+  /* Only clang runs concurrently. Anything creating our own data, such as
+   * interned strings, happens in the order of the files, so that the result
+   * does not depend on the number of jobs. */
+  std::vector<translation_unitt> new_units(paths.size());
+  std::vector<std::vector<std::string>> invocations(paths.size());
+  std::vector<std::string> pchs(paths.size());
+  std::vector<size_t> to_build;
+  for (size_t i = 0; i < paths.size(); i++)
+  {
+    const std::string &path = paths[i];
+
+    // preprocessing
+
+    std::ostringstream o_preprocessed;
+    if (preprocess(path, o_preprocessed))
+      return true;
+
+    // Get compiler arguments and add the file path
+    std::vector<std::string> &new_compiler_args = invocations[i];
+    new_compiler_args = compiler_args("clang-tool");
+    new_compiler_args.push_back(path);
+
+    if (FILE *f = messaget::state.target("clang", VerbosityLevel::Debug))
+    {
+      fprintf(f, "clang invocation:");
+      for (const std::string &s : new_compiler_args)
+        fprintf(f, " '%s'", s.c_str());
+      fprintf(f, "\n");
+    }
+
+    translation_unitt &unit = new_units[i];
+    unit.path = path;
+    if (tu_cache)
+    {
+      unit.cache_key = tu_cache->key(
+        path, tu_cache_args(new_compiler_args), tu_cache_salt(intrinsics));
+      if (
+        !unit.cache_key.empty() &&
+        tu_cache->lookup(unit.cache_key, unit.symbols))
+      {
+        log_progress("Reusing the cached conversion of {}", path);
+        continue;
+      }
+    }
+
+    // Files given by -include come before the main file's own includes
+    if (pch_cache && config.ansi_c.include_files.empty())
+      pchs[i] = prelude_pch(intrinsics, new_compiler_args);
+
+    to_build.push_back(i);
+  }
 
-  // Get compiler arguments and add the file path
-  std::vector<std::string> new_compiler_args = compiler_args("clang-tool");
-  new_compiler_args.push_back(path);
+  // Generate the ASTUnits
+  std::vector<std::unique_ptr<clang::ASTUnit>> newASTs(paths.size());
+  bounded_worker_poolt pool(jobs);
+  pool.run(to_build, [&](size_t i) {
+    newASTs[i] = buildASTs(intrinsics, invocations[i], pchs[i]);
+  });
 
-  if (FILE *f = messaget::state.target("clang", VerbosityLevel::Debug))
+  for (size_t i = 0; i < paths.size(); i++)
   {
-    fprintf(f, "clang invocation:");
-    for (const std::string &s : new_compiler_args)
-      fprintf(f, " '%s'", s.c_str());
-    fprintf(f, "\n");
+    std::unique_ptr<clang::ASTUnit> &newAST = newASTs[i];
+    translation_unitt &unit = new_units[i];
+
+    // Use diagnostics to find errors, rather than the return code.
+    if (newAST && newAST->getDiagnostics().hasErrorOccurred())
+      return true;
+
+    if (tu_cache)
+    {
+      if (newAST)
+      {
+        unit.inputs = getInputFiles(*newAST);
+        unit.AST = std::move(newAST);
+      }
+      units.push_back(std::move(unit));
+    }
+    else if (!AST)
+      AST = move(newAST);
+    else
+      mergeASTs(newAST, AST);
   }
 
-  // Get intrinsics
-  std::string intrinsics = internal_additions();
+  return false;
+}
 
-  // Generate ASTUnit and add to our vector
-  auto newAST = buildASTs(intrinsics, new_compiler_args);
+/* The headers we bundle are extracted to a fresh temporary directory by
+ * every run. Refer to them by a placeholder in the cache key, their contents
+ * are covered by the version in the salt. */
+static std::vector<std::string> internal_header_dirs(const std::string &res)
+{
+  std::vector<std::string> dirs{res};
+  if (const std::string *libc_headers = internal_libc_header_dir())
+    dirs.push_back(*libc_headers);
+  return dirs;
+}
 
-  // Use diagnostics to find errors, rather than the return code.
-  if (newAST->getDiagnostics().hasErrorOccurred())
-    return true;
+static bool is_internal_header(
+  const std::string &path,
+  const std::vector<std::string> &dirs)
+{
+  for (const std::string &dir : dirs)
+    if (has_prefix(path, dir))
+      return true;
+  return false;
+}
 
-  if (!AST)
-    AST = move(newAST);
-  else
-    mergeASTs(newAST, AST);
+std::vector<std::string>
+clang_c_languaget::tu_cache_args(const std::vector<std::string> &args) const
+{
+  std::vector<std::string> dirs = internal_header_dirs(clang_resource_dir());
+  std::vector<std::string> key_args;
+  for (std::string arg : args)
+  {
+    for (const std::string &dir : dirs)
+      if (has_prefix(arg, dir))
+        arg = "<esbmc>" + arg.substr(dir.size());
+    key_args.push_back(std::move(arg));
+  }
+  return key_args;
+}
+
+std::string
+clang_c_languaget::tu_cache_salt(const std::string &intrinsics) const
+{
+  // Settings the conversion reads besides the compiler invocation
+  std::ostringstream salt;
+  salt << "ESBMC " << ESBMC_VERSION << "\n"
+       << intrinsics << "\n"
+       << "char_width=" << config.ansi_c.char_width << "\n"
+       << "use_fixed_for_float=" << config.ansi_c.use_fixed_for_float << "\n"
+       << "no-string-literal="
+       << config.options.get_bool_option("no-string-literal") << "\n";
+  return salt.str();
+}
+
+/* The `#include <...>` lines the file at `path` starts with, skipping blank
+ * lines and comments. Nothing else can come before them, so they may go
+ * into the precompiled prelude: when the file includes them again, the
+ * headers' include guards are already defined. */
+static std::string leading_system_includes(const std::string &path)
+{
+  std::ifstream in(path);
+  std::string includes, line;
+  bool in_comment = false;
+  while (std::getline(in, line))
+  {
+    size_t begin = line.find_first_not_of(" \t\r\f\v");
+    std::string text =
+      begin == std::string::npos
+        ? ""
+        : line.substr(begin, line.find_last_not_of(" \t\r\f\v") + 1 - begin);
+
+    if (in_comment)
+    {
+      // Only if the comment ends the line
+      size_t end = text.find("*/");
+      if (end != std::string::npos && end + 2 != text.size())
+        break;
+      in_comment = end == std::string::npos;
+      continue;
+    }
+
+    if (text.empty() || has_prefix(text, "//"))
+      continue;
+
+    if (has_prefix(text, "/*"))
+    {
+      size_t end = text.find("*/", 2);
+      if (end != std::string::npos && end + 2 != text.size())
+        break;
+      in_comment = end == std::string::npos;
+      continue;
+    }
+
+    // # include <header>, with nothing after it
+    size_t pos = text.find_first_not_of(" \t", 1);
+    if (
+      text[0] != '#' || pos == std::string::npos ||
+      text.compare(pos, 7, "include") != 0)
+      break;
+    pos = text.find_first_not_of(" \t", pos + 7);
+    if (
+      pos == std::string::npos || text[pos] != '<' ||
+      text.find('>', pos) + 1 != text.size())
+      break;
+
+    includes += text + "\n";
+  }
+
+  return includes;
+}
+
+std::string clang_c_languaget::prelude_pch(
+  const std::string &intrinsics,
+  const std::vector<std::string> &compiler_args)
+{
+  const std::string &path = compiler_args.back();
+  std::string prelude = intrinsics + "\n" + leading_system_includes(path);
+  std::vector<std::string> args(compiler_args.begin(), compiler_args.end() - 1);
+
+  // Our bundled headers keep their paths with --pch-cache, and the paths
+  // name their contents
+  std::string key = pch_cache->key(args, tu_cache_salt(prelude));
+  std::string pch = pch_cache->lookup_pch(key);
+  if (!pch.empty())
+    return pch;
+
+  std::string tmp = pch_cache->temporary_path(key, ".pch");
+  std::vector<std::string> inputs;
+  if (buildPCH(prelude, args, tmp, inputs))
+  {
+    log_warning("Failed to precompile the headers of {}", path);
+    boost::system::error_code ec;
+    boost::filesystem::remove(tmp, ec);
+    return "";
+  }
+
+  return pch_cache->store_pch(key, inputs, tmp);
+}
+
+bool clang_c_languaget::typecheck_units(contextt &context)
+{
+  std::vector<std::string> dirs = internal_header_dirs(clang_resource_dir());
+
+  for (translation_unitt &unit : units)
+  {
+    if (unit.AST)
+    {
+      clang_c_convertert converter(unit.symbols, unit.AST, "C");
+      if (converter.convert())
+        return true;
+
+      clang_c_adjust adjuster(unit.symbols);
+      if (adjuster.adjust())
+        return true;
+
+      std::vector<std::string> inputs;
+      for (const std::string &input : unit.inputs)
+        if (!is_internal_header(input, dirs))
+          inputs.push_back(input);
+
+      if (!unit.cache_key.empty())
+        tu_cache->store(unit.cache_key, inputs, unit.symbols);
+    }
+
+    if (c_link(context, unit.symbols, unit.path))
+      return true;
+  }
 
   return false;
 }
 
 bool clang_c_languaget::typecheck(contextt &context, const std::string &)
 {
+  if (!units.empty())
+    return typecheck_units(context);
+
   clang_c_convertert converter(context, AST, "C");
   if (converter.convert())
     return true;
@@ -332,7 +573,12 @@ bool clang_c_languaget::typecheck(contextt &context, const std::string &)
 
 void clang_c_languaget::show_parse(std::ostream &)
 {
-  AST->getASTContext().getTranslationUnitDecl()->dump();
+  if (AST)
+    AST->getASTContext().getTranslationUnitDecl()->dump();
+
+  for (const translation_unitt &unit : units)
+    if (unit.AST)
+      unit.AST->getASTContext().getTranslationUnitDecl()->dump();
 }
 
 bool clang_c_languaget::preprocess(const std::string &, std::ostream &)
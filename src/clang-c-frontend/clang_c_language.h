@@ -1,6 +1,7 @@
 #ifndef CLANG_C_FRONTEND_CLANG_C_LANGUAGE_H_
 #define CLANG_C_FRONTEND_CLANG_C_LANGUAGE_H_
 
+#include <clang-c-frontend/tu_cache.h>
 #include <util/language.h>
 
 #define __STDC_LIMIT_MACROS
@@ -19,6 +20,9 @@ public:
 
   bool parse(const std::string &path) override;
 
+  bool parse_files(const std::vector<std::string> &paths, unsigned jobs)
+    override;
+
   bool final(contextt &context) override;
 
   bool typecheck(contextt &context, const std::string &module) override;
@@ -101,6 +105,33 @@ protected:
   }
 
   std::unique_ptr<clang::ASTUnit> AST;
+
+  /* With --tu-cache, each source file is converted into its own symbol table
+   * and linked in typecheck(), instead of merging all the ASTs, so that the
+   * symbols of unchanged files can be taken from the cache. */
+  struct translation_unitt
+  {
+    std::string path;
+    std::string cache_key;
+    std::vector<std::string> inputs;
+    // Null when the symbols were loaded from the cache
+    std::unique_ptr<clang::ASTUnit> AST;
+    contextt symbols;
+  };
+
+  std::vector<translation_unitt> units;
+  std::unique_ptr<tu_cachet> tu_cache;
+
+  // Precompiled intrinsics and leading system includes, see --pch-cache
+  std::unique_ptr<tu_cachet> pch_cache;
+  std::string prelude_pch(
+    const std::string &intrinsics,
+    const std::vector<std::string> &compiler_args);
+
+  bool typecheck_units(contextt &context);
+  std::vector<std::string>
+  tu_cache_args(const std::vector<std::string> &args) const;
+  std::string tu_cache_salt(const std::string &intrinsics) const;
 };
 
 languaget *new_clang_c_language();
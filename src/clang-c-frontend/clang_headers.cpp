@@ -2,6 +2,8 @@
 #include <boost/filesystem.hpp>
 #include <fstream>
 #include <ac_config.h>
+#include <util/config.h>
+#include <util/crypto_hash.h>
 #include <util/filesystem.h>
 
 #ifdef ESBMC_CLANG_HEADERS_BUNDLED
@@ -12,9 +14,44 @@ extern "C"
 }
 #endif
 
+#ifdef ESBMC_CLANG_HEADERS_BUNDLED
+static void write_clang_headers(const std::string &dir)
+{
+  std::string path = dir + "/include";
+  boost::filesystem::create_directories(path);
+#  define ESBMC_FLAIL(body, size, ...)                                         \
+    std::ofstream(path + "/" #__VA_ARGS__).write(body, size);
+#  include <headers/cheaders.h>
+#  undef ESBMC_FLAIL
+}
+
+static std::string clang_headers_hash()
+{
+  crypto_hash hash;
+#  define ESBMC_FLAIL(body, size, ...)                                         \
+    hash.ingest(#__VA_ARGS__, sizeof(#__VA_ARGS__));                           \
+    hash.ingest(&size, sizeof(size));                                          \
+    hash.ingest(body, size);
+#  include <headers/cheaders.h>
+#  undef ESBMC_FLAIL
+  hash.fin();
+  return hash.to_string();
+}
+#endif
+
 const std::string &clang_c_languaget::clang_resource_dir()
 {
 #ifdef ESBMC_CLANG_HEADERS_BUNDLED
+  /* Precompiled headers refer to the headers by path, so with --pch-cache
+   * they are kept next to them, where later runs find them again */
+  static const std::string shared = config.options.get_option("pch-cache");
+  if (!shared.empty())
+  {
+    static const std::string path = file_operations::create_shared_dir(
+      shared, "clang-headers-" + clang_headers_hash(), write_clang_headers);
+    return path;
+  }
+
   // Dump clang headers into a temporary directory
   static bool dumped = false;
   /* About the path being static:
@@ -25,12 +62,7 @@ const std::string &clang_c_languaget::clang_resource_dir()
     file_operations::create_tmp_dir("esbmc-headers-%%%%-%%%%-%%%%");
   if (!dumped)
   {
-    std::string path = tmp.path() + "/include";
-    boost::filesystem::create_directories(path);
-#  define ESBMC_FLAIL(body, size, ...)                                         \
-    std::ofstream(path + "/" #__VA_ARGS__).write(body, size);
-#  include <headers/cheaders.h>
-#  undef ESBMC_FLAIL
+    write_clang_headers(tmp.path());
     dumped = true;
   }
   return tmp.path();
@@ -0,0 +1,245 @@
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <clang-c-frontend/tu_cache.h>
+#include <cstdint>
+#include <fstream>
+#include <goto-programs/goto_binary_index.h>
+#include <goto-programs/write_goto_binary.h>
+#include <sstream>
+#include <util/config.h>
+#include <util/crypto_hash.h>
+#include <util/message.h>
+
+static const char tu_cache_header[] = "esbmc-tu-cache 1";
+static const char no_slice_tag[] = "no-slice";
+
+static void ingest_string(crypto_hash &hash, const std::string &s)
+{
+  // Length prefixed, so that different splits of the same bytes differ
+  uint64_t size = s.size();
+  hash.ingest(&size, sizeof(size));
+  hash.ingest(s.data(), s.size());
+}
+
+tu_cachet::tu_cachet(std::string dir) : dir(std::move(dir))
+{
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(this->dir, ec);
+  if (ec)
+    log_warning(
+      "Failed to create the TU cache {}: {}", this->dir, ec.message());
+}
+
+std::string tu_cachet::entry_path(const std::string &key, const char *ext) const
+{
+  return (boost::filesystem::path(dir) / (key + ext)).string();
+}
+
+std::string tu_cachet::file_hash(const std::string &path)
+{
+  std::ifstream in(path, std::ios::binary);
+  if (!in)
+    return "";
+
+  crypto_hash hash;
+  char buf[1 << 16];
+  while (in.read(buf, sizeof(buf)) || in.gcount() > 0)
+    hash.ingest(buf, in.gcount());
+
+  if (in.bad())
+    return "";
+
+  hash.fin();
+  return hash.to_string();
+}
+
+std::string tu_cachet::key(
+  const std::string &path,
+  const std::vector<std::string> &args,
+  const std::string &salt) const
+{
+  std::string contents = file_hash(path);
+  if (contents.empty())
+    return "";
+
+  // The path ends up in the symbols' locations
+  std::vector<std::string> parts = args;
+  parts.push_back(path);
+  parts.push_back(contents);
+  return key(parts, salt);
+}
+
+std::string tu_cachet::key(
+  const std::vector<std::string> &args,
+  const std::string &salt) const
+{
+  crypto_hash hash;
+  ingest_string(hash, salt);
+  for (const std::string &arg : args)
+    ingest_string(hash, arg);
+  hash.fin();
+  return hash.to_string();
+}
+
+bool tu_cachet::valid(
+  const std::string &key,
+  std::vector<std::string> &no_slice) const
+{
+  std::ifstream deps(entry_path(key, ".deps"));
+  std::string line;
+  if (!deps || !std::getline(deps, line) || line != tu_cache_header)
+    return false;
+
+  // Every line is the hash of an input file, a space and its path, or a
+  // variable declared __ESBMC_no_slice
+  while (std::getline(deps, line))
+  {
+    size_t sep = line.find(' ');
+    if (sep == std::string::npos)
+      return false;
+    if (line.compare(0, sep, no_slice_tag) == 0)
+      no_slice.push_back(line.substr(sep + 1));
+    else if (file_hash(line.substr(sep + 1)) != line.substr(0, sep))
+      return false;
+  }
+
+  return true;
+}
+
+bool tu_cachet::lookup(const std::string &key, contextt &context) const
+{
+  std::vector<std::string> no_slice;
+  if (!valid(key, no_slice))
+    return false;
+
+  boost::iostreams::mapped_file_source file;
+  try
+  {
+    file.open(entry_path(key, ".goto"));
+  }
+  catch (const std::exception &)
+  {
+    return false;
+  }
+
+  goto_binary_indext index;
+  if (
+    !goto_binary_indext::is_indexed(file.data(), file.size()) ||
+    index.load(file.data(), file.size()))
+    return false;
+
+  for (const goto_binary_indext::entryt &e : index.symbols())
+  {
+    symbolt symbol;
+    index.read_symbol(e, symbol);
+    context.move(symbol);
+  }
+
+  // The converter records these as it goes, see clang_c_convertert
+  config.no_slice_names.insert(no_slice.begin(), no_slice.end());
+  return true;
+}
+
+std::string tu_cachet::lookup_pch(const std::string &key) const
+{
+  std::vector<std::string> no_slice;
+  std::string pch = entry_path(key, ".pch");
+  if (!valid(key, no_slice) || !boost::filesystem::exists(pch))
+    return "";
+  return pch;
+}
+
+std::string
+tu_cachet::temporary_path(const std::string &key, const char *ext) const
+{
+  std::string tmp = boost::filesystem::unique_path().string();
+  return entry_path(key, (ext + ("." + tmp)).c_str());
+}
+
+void tu_cachet::store(
+  const std::string &key,
+  const std::vector<std::string> &inputs,
+  const contextt &context) const
+{
+  std::ostringstream no_slice;
+  context.foreach_operand([&no_slice](const symbolt &s) {
+    if (config.no_slice_names.count(s.id.as_string()))
+      no_slice << no_slice_tag << " " << s.id << "\n";
+  });
+
+  goto_functionst no_functions;
+  std::string goto_tmp = temporary_path(key, ".goto");
+  {
+    std::ofstream out(goto_tmp, std::ios::binary);
+    if (!out || write_goto_binary(out, context, no_functions))
+    {
+      log_warning("Failed to write the TU cache entry {}", goto_tmp);
+      boost::system::error_code ec;
+      boost::filesystem::remove(goto_tmp, ec);
+      return;
+    }
+  }
+
+  store_entry(key, inputs, no_slice.str(), goto_tmp, ".goto");
+}
+
+std::string tu_cachet::store_pch(
+  const std::string &key,
+  const std::vector<std::string> &inputs,
+  const std::string &pch) const
+{
+  if (store_entry(key, inputs, "", pch, ".pch"))
+    return "";
+  return entry_path(key, ".pch");
+}
+
+bool tu_cachet::store_entry(
+  const std::string &key,
+  const std::vector<std::string> &inputs,
+  const std::string &extra,
+  const std::string &data_tmp,
+  const char *ext) const
+{
+  std::ostringstream deps;
+  deps << tu_cache_header << "\n";
+  for (const std::string &input : inputs)
+  {
+    // Files that aren't on disk, e.g. our headers built into the binary,
+    // are covered by the tool version in the key
+    std::string hash = file_hash(input);
+    if (!hash.empty())
+      deps << hash << " " << input << "\n";
+  }
+  deps << extra;
+
+  // Write to temporaries and move them in place, so that concurrent runs
+  // never see a partial entry. The data goes first: an entry only counts
+  // once its .deps exists.
+  std::string deps_tmp = temporary_path(key, ".deps");
+  {
+    std::ofstream out(deps_tmp);
+    out << deps.str();
+    if (!out)
+    {
+      log_warning("Failed to write the TU cache entry {}", deps_tmp);
+      boost::system::error_code ec;
+      boost::filesystem::remove(data_tmp, ec);
+      boost::filesystem::remove(deps_tmp, ec);
+      return true;
+    }
+  }
+
+  boost::system::error_code ec;
+  boost::filesystem::rename(data_tmp, entry_path(key, ext), ec);
+  if (!ec)
+    boost::filesystem::rename(deps_tmp, entry_path(key, ".deps"), ec);
+  if (ec)
+  {
+    log_warning("Failed to write the TU cache entry {}: {}", key, ec.message());
+    boost::filesystem::remove(data_tmp, ec);
+    boost::filesystem::remove(deps_tmp, ec);
+    return true;
+  }
+
+  return false;
+}
@@ -0,0 +1,88 @@
+#ifndef CLANG_C_FRONTEND_TU_CACHE_H_
+#define CLANG_C_FRONTEND_TU_CACHE_H_
+
+#include <string>
+#include <util/context.h>
+#include <vector>
+
+/**
+ * @brief Directory of converted C translation units, see --tu-cache.
+ *
+ * An entry holds the symbol table clang_c_convertert and clang_c_adjust
+ * produced for one source file, stored as a goto-binary, along with the
+ * files the translation unit was read from and their hashes and the
+ * variables it declares __ESBMC_no_slice. Like ccache's direct mode, an
+ * entry is reused when the source file, the compiler invocation and each of
+ * those files are unchanged, so that only the files touched since the last
+ * run need to go through clang again.
+ *
+ * Entries may also hold a precompiled header instead, see --pch-cache.
+ */
+class tu_cachet
+{
+public:
+  explicit tu_cachet(std::string dir);
+
+  /**
+   * Key of the source file `path` compiled with `args`. `salt` should hold
+   * anything else the conversion depends on. Empty if `path` can't be read.
+   */
+  std::string key(
+    const std::string &path,
+    const std::vector<std::string> &args,
+    const std::string &salt) const;
+
+  /// Key of an entry that depends on nothing but `args` and `salt`
+  std::string
+  key(const std::vector<std::string> &args, const std::string &salt) const;
+
+  /**
+   * Adds the symbols stored for `key` to `context`.
+   * @return whether there was an entry and its inputs are unchanged */
+  bool lookup(const std::string &key, contextt &context) const;
+
+  /// Stores `context` for `key`, which was read from the files in `inputs`
+  void store(
+    const std::string &key,
+    const std::vector<std::string> &inputs,
+    const contextt &context) const;
+
+  /**
+   * Path of the precompiled header stored for `key`.
+   * @return empty if there is no entry or its inputs changed */
+  std::string lookup_pch(const std::string &key) const;
+
+  /**
+   * Moves the precompiled header `pch`, read from `inputs`, into the cache.
+   * @return its new path, or empty on failure */
+  std::string store_pch(
+    const std::string &key,
+    const std::vector<std::string> &inputs,
+    const std::string &pch) const;
+
+  /// A fresh path in the cache directory to build files for `key` in
+  std::string temporary_path(const std::string &key, const char *ext) const;
+
+  /// Hash of the contents of the file `path`, or empty if it can't be read
+  static std::string file_hash(const std::string &path);
+
+protected:
+  const std::string dir;
+
+  std::string entry_path(const std::string &key, const char *ext) const;
+
+  /* Whether the entry `key` exists and the files it was read from are
+   * unchanged; adds the __ESBMC_no_slice variables it lists to `no_slice` */
+  bool valid(const std::string &key, std::vector<std::string> &no_slice) const;
+
+  /* Moves `data_tmp` into place as the `ext` file of the entry `key` and
+   * records `inputs` and the lines `extra` in its .deps; true on error */
+  bool store_entry(
+    const std::string &key,
+    const std::vector<std::string> &inputs,
+    const std::string &extra,
+    const std::string &data_tmp,
+    const char *ext) const;
+};
+
+#endif
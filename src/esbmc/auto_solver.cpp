@@ -0,0 +1,207 @@
+#include <esbmc/auto_solver.h>
+#include <fstream>
+#include <solvers/solve.h>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <util/message.h>
+
+const char auto_solvert::default_rules[] =
+  "# Floating-point arithmetic is best left to a solver supporting it\n"
+  "float : solver=bitwuzla fp=native\n"
+  "float : solver=z3 fp=native\n"
+  "# Non-linear arithmetic\n"
+  "nonlinear, !bitwise : solver=z3\n"
+  "nonlinear : solver=bitwuzla\n"
+  "# Large formulas over arrays\n"
+  "array, nodes >= 200000 : solver=yices\n"
+  "* : solver=boolector\n"
+  "* : solver=bitwuzla\n"
+  "* : solver=z3\n";
+
+static const std::unordered_map<std::string, SSA_FEATURES> feature_names = {
+  {"nonlinear", SSA_FEATURES::NON_LINEAR},
+  {"non-integer-numeral", SSA_FEATURES::NON_INTEGER_NUMERAL},
+  {"bitwise", SSA_FEATURES::BITWISE_OPERATIONS},
+  {"overflow", SSA_FEATURES::OVERFLOW_ASSERTIONS},
+  {"array", SSA_FEATURES::ARRAY},
+  {"struct", SSA_FEATURES::STRUCTS},
+  {"float", SSA_FEATURES::FLOATING_POINT}};
+
+// Solvers that abort in integer/real arithmetic mode
+static const std::unordered_set<std::string> bv_only_solvers = {
+  "boolector",
+  "bitwuzla"};
+
+static std::string trim(const std::string &s)
+{
+  size_t begin = s.find_first_not_of(" \t\r");
+  if (begin == std::string::npos)
+    return "";
+  size_t end = s.find_last_not_of(" \t\r");
+  return s.substr(begin, end - begin + 1);
+}
+
+auto_solvert::auto_solvert(const optionst &options, const std::string &file)
+{
+  std::string source = "<built-in>";
+  std::istringstream builtin(default_rules);
+  std::ifstream in;
+  std::istream *table = &builtin;
+  if (!file.empty())
+  {
+    in.open(file);
+    if (!in)
+    {
+      log_error("Cannot open solver rules file {}", file);
+      abort();
+    }
+    source = file;
+    table = &in;
+  }
+
+  std::string line;
+  for (unsigned n = 1; std::getline(*table, line); n++)
+  {
+    line = trim(line.substr(0, line.find('#')));
+    if (line.empty())
+      continue;
+
+    rulet rule;
+    rule.options = options;
+    std::string error = parse(line, rule);
+    if (!error.empty())
+    {
+      log_error("{}:{}: {}", source, n, error);
+      abort();
+    }
+    rules.push_back(std::move(rule));
+  }
+}
+
+std::string auto_solvert::parse(const std::string &line, rulet &rule)
+{
+  rule.text = line;
+
+  size_t colon = line.find(':');
+  if (colon == std::string::npos)
+    return "expected ':' between the conditions and the settings";
+
+  std::istringstream conditions(line.substr(0, colon));
+  std::string c;
+  while (std::getline(conditions, c, ','))
+  {
+    c = trim(c);
+    if (c == "*")
+      continue;
+    if (c.empty())
+      return "empty condition";
+
+    conditiont condition;
+    size_t op = c.find_first_of("<>=");
+    if (op == std::string::npos)
+    {
+      condition.negated = c[0] == '!';
+      auto it = feature_names.find(trim(c.substr(condition.negated)));
+      if (it == feature_names.end())
+        return "unknown feature '" + c + "'";
+      condition.feature = it->second;
+    }
+    else
+    {
+      condition.is_feature = false;
+      condition.metric = trim(c.substr(0, op));
+      size_t value = c.find_first_not_of("<>=", op);
+      condition.op = c.substr(op, value - op);
+      if (
+        condition.metric != "steps" && condition.metric != "nodes" &&
+        condition.metric != "depth")
+        return "unknown metric '" + condition.metric + "'";
+      if (
+        condition.op != "<" && condition.op != "<=" && condition.op != ">" &&
+        condition.op != ">=" && condition.op != "==")
+        return "unknown comparison '" + condition.op + "'";
+
+      const std::string number =
+        value == std::string::npos ? "" : trim(c.substr(value));
+      if (
+        number.empty() ||
+        number.find_first_not_of("0123456789") != std::string::npos)
+        return "expected a number after '" + condition.op + "'";
+      condition.value = std::stoull(number);
+    }
+    rule.conditions.push_back(std::move(condition));
+  }
+
+  std::istringstream settings(line.substr(colon + 1));
+  std::string s;
+  while (settings >> s)
+  {
+    size_t eq = s.find('=');
+    const std::string key = s.substr(0, eq);
+    const std::string value = eq == std::string::npos ? "" : s.substr(eq + 1);
+    optionst &options = rule.options;
+    if (key == "solver" && !value.empty())
+      rule.solver = value;
+    else if (key == "tuple" && (value == "node" || value == "sym"))
+    {
+      options.set_option("tuple-node-flattener", value == "node");
+      options.set_option("tuple-sym-flattener", value == "sym");
+    }
+    else if (key == "tuple" && value == "native")
+    {
+      options.set_option("tuple-node-flattener", false);
+      options.set_option("tuple-sym-flattener", false);
+    }
+    else if (key == "array" && (value == "flattener" || value == "native"))
+      options.set_option("array-flattener", value == "flattener");
+    else if (key == "fp" && (value == "bv" || value == "native"))
+      options.set_option("fp2bv", value == "bv");
+    else
+      return "unknown setting '" + s + "'";
+  }
+
+  if (rule.solver.empty())
+    return "the rule picks no solver";
+
+  return "";
+}
+
+bool auto_solvert::conditiont::holds(const ssa_features &f) const
+{
+  if (is_feature)
+    return f.features.count(feature) != negated;
+
+  const size_t v = metric == "steps" ? f.steps
+                   : metric == "nodes" ? f.nodes
+                                       : f.depth;
+  if (op == "<")
+    return v < value;
+  if (op == "<=")
+    return v <= value;
+  if (op == ">")
+    return v > value;
+  if (op == ">=")
+    return v >= value;
+  return v == value;
+}
+
+const auto_solvert::rulet *auto_solvert::pick(const ssa_features &f) const
+{
+  for (const rulet &rule : rules)
+  {
+    if (
+      !is_solver_available(rule.solver) ||
+      (rule.options.get_bool_option("int-encoding") &&
+       bv_only_solvers.count(rule.solver)))
+      continue;
+
+    bool holds = true;
+    for (const conditiont &c : rule.conditions)
+      holds = holds && c.holds(f);
+    if (holds)
+      return &rule;
+  }
+
+  return nullptr;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <goto-symex/features.h>
+#include <string>
+#include <util/options.h>
+#include <vector>
+
+/**
+ * @brief Picks the solver and its encoding for each formula from the
+ * features ssa_features finds in it, see --auto-solver
+ *
+ * The rules are read from a file, one per line, or the built-in table is
+ * used. Each rule has comma-separated conditions before a colon and the
+ * settings it picks after it:
+ *
+ *   float, !nonlinear : solver=bitwuzla fp=native
+ *   nodes >= 100000 : solver=yices array=flattener
+ *   * : solver=boolector
+ *
+ * A condition is a feature (nonlinear, non-integer-numeral, bitwise,
+ * overflow, array, struct, float), maybe negated with '!', or a comparison
+ * of a metric (steps, nodes, depth) with a number; '*' always holds. The
+ * settings are solver=<name>, tuple=node|sym|native, array=flattener|native
+ * and fp=bv|native. The first rule whose conditions all hold and whose
+ * solver is built in wins. scripts/auto_solver/calibrate.py builds a table
+ * from benchmark runs.
+ */
+class auto_solvert
+{
+public:
+  /// Reads the rules in `file`, or the built-in ones if it is empty
+  auto_solvert(const optionst &options, const std::string &file);
+
+  struct conditiont
+  {
+    /// Set for a feature, otherwise `metric` is compared with `value`
+    bool is_feature = true;
+    SSA_FEATURES feature = SSA_FEATURES::NON_LINEAR;
+    bool negated = false;
+    std::string metric;
+    std::string op;
+    size_t value = 0;
+
+    bool holds(const ssa_features &f) const;
+  };
+
+  struct rulet
+  {
+    std::string text;
+    std::vector<conditiont> conditions;
+    std::string solver;
+    /// The options of the run with the settings of this rule applied
+    optionst options;
+  };
+
+  /// The rule for a formula with features `f`, nullptr if none applies
+  const rulet *pick(const ssa_features &f) const;
+
+  const std::vector<rulet> &get_rules() const
+  {
+    return rules;
+  }
+
+  static const char default_rules[];
+
+protected:
+  std::vector<rulet> rules;
+
+  /* Parses `line` of the table into `rule`, returning an error message or
+   * an empty string */
+  static std::string parse(const std::string &line, rulet &rule);
+};
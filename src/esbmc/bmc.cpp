@@ -2,8 +2,12 @@
 #include <memory>
 #include <sys/types.h>
 #include <algorithm>
+#include <optional>
+#include <set>
 #include <thread>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 #ifndef _WIN32
 #  include <unistd.h>
@@ -31,12 +35,14 @@
 #include <sstream>
 #include <util/i2string.h>
 #include <irep2/irep2.h>
+#include <irep2/irep2_hashcons.h>
 #include <util/location.h>
 
 #include <util/migrate.h>
 #include <util/show_symbol_table.h>
 #include <util/time_stopping.h>
 #include <util/cache.h>
+#include <util/thread_pool.h>
 #include <atomic>
 #include <goto-symex/witnesses.h>
 
@@ -76,6 +82,10 @@ bmct::bmct(goto_functionst &funcs, optionst &opts, contextt &_context)
       algorithms.emplace_back(std::make_unique<ssa_features>());
   }
 
+  if (options.get_bool_option("auto-solver"))
+    auto_solver = std::make_unique<auto_solvert>(
+      options, options.get_option("auto-solver-rules"));
+
   if (options.get_bool_option("smt-during-symex"))
   {
     runtime_solver = std::unique_ptr<smt_convt>(create_solver("", ns, options));
@@ -165,7 +175,8 @@ void bmct::error_trace(smt_convt &smt_conv, const symex_target_equationt &eq)
 
 void bmct::generate_smt_from_equation(
   smt_convt &smt_conv,
-  symex_target_equationt &eq) const
+  symex_target_equationt &eq,
+  bool assert_claims) const
 {
   std::string logic;
 
@@ -181,7 +192,10 @@ void bmct::generate_smt_from_equation(
   log_status("Encoding remaining VCC(s) using {}", logic);
 
   fine_timet encode_start = current_time();
-  eq.convert(smt_conv);
+  if (assert_claims)
+    eq.convert(smt_conv);
+  else
+    eq.convert_without_claims(smt_conv);
   fine_timet encode_stop = current_time();
   log_status(
     "Encoding to solver time: {}s", time2string(encode_stop - encode_start));
@@ -208,33 +222,43 @@ smt_convt::resultt bmct::run_decision_procedure(
   smt_convt &smt_conv,
   symex_target_equationt &eq) const
 {
-  if (options.get_bool_option("enable-keep-alive"))
-  {
-    keep_alive_running = true;
-    keep_alive_interval =
-      atoi(options.get_option("keep-alive-interval").c_str());
+  start_keep_alive();
+  generate_smt_from_equation(smt_conv, eq);
+  return solve_encoded(smt_conv);
+}
 
-    if (keep_alive_interval <= 0)
-      keep_alive_interval = 60; // Default interval to 60 seconds
+void bmct::start_keep_alive() const
+{
+  if (!options.get_bool_option("enable-keep-alive"))
+    return;
 
-    std::thread([this]() { keep_alive_function(); }).detach();
-  }
+  keep_alive_running = true;
+  keep_alive_interval = atoi(options.get_option("keep-alive-interval").c_str());
 
-  generate_smt_from_equation(smt_conv, eq);
+  if (keep_alive_interval <= 0)
+    keep_alive_interval = 60; // Default interval to 60 seconds
+
+  std::thread([this]() { keep_alive_function(); }).detach();
+}
 
+smt_convt::resultt bmct::solve_encoded(smt_convt &smt_conv) const
+{
   if (
     options.get_bool_option("smt-formula-too") ||
     options.get_bool_option("smt-formula-only"))
   {
     smt_conv.dump_smt();
     if (options.get_bool_option("smt-formula-only"))
+    {
+      keep_alive_running = false;
       return smt_convt::P_SMTLIB;
+    }
   }
 
   log_progress("Solving with solver {}", smt_conv.solver_text());
 
   fine_timet sat_start = current_time();
-  smt_convt::resultt dec_result = smt_conv.dec_solve();
+  smt_convt::resultt dec_result = smt_conv.dec_solve_refined();
   fine_timet sat_stop = current_time();
   keep_alive_running = false;
 
@@ -245,6 +269,146 @@ smt_convt::resultt bmct::run_decision_procedure(
   return dec_result;
 }
 
+smt_convt *
+bmct::create_formula_solver(const symex_target_equationt &eq) const
+{
+  if (!auto_solver)
+    return create_solver("", ns, options);
+
+  ssa_features features;
+  features.collect(eq.SSA_steps);
+  const auto_solvert::rulet *rule = auto_solver->pick(features);
+  if (!rule)
+  {
+    log_status("No solver rule applies, using the default solver");
+    return create_solver("", ns, options);
+  }
+
+  log_status("Rule '{}' picked solver {}", rule->text, rule->solver);
+  return create_solver(rule->solver, ns, rule->options);
+}
+
+/* Races the solvers given to --portfolio, each on its own copy of the
+ * equation, as encoding fills in the ASTs of the steps. The first definitive
+ * answer wins: its solver becomes the runtime solver and its copy `eq`, so
+ * that the trace is built from its model. */
+smt_convt::resultt
+bmct::run_portfolio(std::shared_ptr<symex_target_equationt> &eq)
+{
+  struct entrantt
+  {
+    std::string solver;
+    std::unique_ptr<smt_convt> smt_conv;
+    std::shared_ptr<symex_target_equationt> eq;
+    smt_convt::resultt result = smt_convt::P_ERROR;
+    std::exception_ptr error;
+    bool done = false;
+  };
+
+  std::vector<entrantt> entrants;
+  std::istringstream solvers(options.get_option("portfolio"));
+  std::string solver;
+  while (std::getline(solvers, solver, ','))
+  {
+    if (solver.empty())
+      continue;
+
+    entrantt &e = entrants.emplace_back();
+    e.solver = solver;
+    e.smt_conv.reset(create_solver(solver, ns, options));
+    e.eq = std::make_shared<symex_target_equationt>(*eq);
+
+    // The answer waits for every loser to stop, which it never would
+    if (!e.smt_conv->can_interrupt())
+    {
+      log_error(
+        "--portfolio can't cancel {}, it only races solvers that can be "
+        "interrupted",
+        e.smt_conv->solver_text());
+      return smt_convt::P_ERROR;
+    }
+  }
+
+  if (entrants.empty())
+  {
+    log_error("--portfolio needs at least one solver");
+    return smt_convt::P_ERROR;
+  }
+
+  std::mutex mutex;
+  std::condition_variable finished;
+  size_t running = entrants.size();
+  entrantt *winner = nullptr;
+
+  std::vector<std::thread> threads;
+  const namespacet *lookup = migrate_namespace_lookup;
+  for (entrantt &e : entrants)
+    threads.emplace_back([&, entrant = &e]() {
+      migrate_namespace_lookup = lookup;
+      smt_convt::resultt result = smt_convt::P_ERROR;
+      std::exception_ptr error;
+      try
+      {
+        result = run_decision_procedure(*entrant->smt_conv, *entrant->eq);
+      }
+      catch (...)
+      {
+        error = std::current_exception();
+      }
+
+      std::lock_guard lock(mutex);
+      entrant->result = result;
+      entrant->error = error;
+      entrant->done = true;
+      --running;
+      if (
+        !winner && (result == smt_convt::P_SATISFIABLE ||
+                    result == smt_convt::P_UNSATISFIABLE))
+        winner = entrant;
+      finished.notify_all();
+    });
+
+  {
+    std::unique_lock lock(mutex);
+    finished.wait(lock, [&]() { return winner || !running; });
+
+    // Solvers still encoding miss the interrupt, so keep asking
+    while (running)
+    {
+      for (entrantt &e : entrants)
+        if (!e.done)
+          e.smt_conv->interrupt();
+      finished.wait_for(
+        lock, std::chrono::milliseconds(100), [&]() { return !running; });
+    }
+  }
+
+  for (std::thread &t : threads)
+    t.join();
+
+  if (!winner)
+  {
+    for (entrantt &e : entrants)
+      if (e.error)
+        std::rethrow_exception(e.error);
+    return entrants.front().result;
+  }
+
+  log_status("{} answered first", winner->smt_conv->solver_text());
+  ++portfolio_wins[winner->solver];
+  runtime_solver = std::move(winner->smt_conv);
+  eq = winner->eq;
+  return winner->result;
+}
+
+void bmct::report_portfolio_wins() const
+{
+  std::ostringstream oss;
+  for (const auto &[solver, wins] : portfolio_wins)
+    oss << "\n  " << solver << ": " << wins;
+  log_status("Solver portfolio wins:{}", oss.str());
+}
+
 void bmct::report_success()
 {
   log_success("\nVERIFICATION SUCCESSFUL");
@@ -870,13 +1034,114 @@ smt_convt::resultt bmct::start_bmc()
     // multi-property traces are output during the run(eq)
     report_trace(res, *eq);
   report_result(res);
+  if (!portfolio_wins.empty())
+    report_portfolio_wins();
   return res;
 }
 
+void bmct::set_incremental_symex(bool enable)
+{
+  incremental_symex = enable;
+  symex->keep_unwind_frontier(enable);
+}
+
+void bmct::reset_encoded_prefix()
+{
+  runtime_solver.reset();
+  suffix_ctx_pushed = false;
+  encoded_prefix.clear();
+  prefix_assumpt_ast = nullptr;
+  prefix_assertions.clear();
+}
+
+smt_convt::resultt
+bmct::run_incremental_decision_procedure(symex_target_equationt &eq)
+{
+  smt_convt &smt_conv = *runtime_solver;
+  start_keep_alive();
+
+  // Drop the suffix of the previous run
+  if (suffix_ctx_pushed)
+    smt_conv.pop_ctx();
+  suffix_ctx_pushed = false;
+
+  if (!prefix_assumpt_ast)
+    prefix_assumpt_ast = smt_conv.convert_ast(gen_true_expr());
+
+  size_t frontier = symex->get_unwind_frontier_steps();
+  size_t idx = 0;
+  fine_timet encode_start = current_time();
+  for (auto &step : eq.SSA_steps)
+  {
+    if (idx < encoded_prefix.size())
+    {
+      // Already in the solver, only hand the ASTs back to the step
+      const encoded_stept &enc = encoded_prefix[idx];
+      step.guard_ast = enc.guard_ast;
+      step.cond_ast = enc.cond_ast;
+      step.converted_output_args = enc.converted_output_args;
+    }
+    else if (idx < frontier)
+    {
+      // Shared with every later run: encode it for good. Slicing is only
+      // valid for this run, so these steps are never sliced away.
+      step.ignore = false;
+      eq.convert_internal_step(
+        smt_conv, prefix_assumpt_ast, prefix_assertions, step);
+      encoded_prefix.push_back(
+        {step.guard_ast, step.cond_ast, step.converted_output_args});
+    }
+    else
+      break;
+
+    ++idx;
+  }
+
+  smt_conv.push_ctx();
+  suffix_ctx_pushed = true;
+
+  smt_astt assumpt_ast = prefix_assumpt_ast;
+  smt_convt::ast_vec assertions = prefix_assertions;
+  for (auto it = std::next(eq.SSA_steps.begin(), idx);
+       it != eq.SSA_steps.end();
+       ++it)
+    eq.convert_internal_step(smt_conv, assumpt_ast, assertions, *it);
+
+  if (!assertions.empty())
+    smt_conv.assert_ast(smt_conv.make_n_ary_or(assertions));
+
+  fine_timet encode_stop = current_time();
+  log_status(
+    "Encoding to solver time: {}s ({} shared step(s) kept in the solver)",
+    time2string(encode_stop - encode_start),
+    encoded_prefix.size());
+
+  return solve_encoded(smt_conv);
+}
+
 smt_convt::resultt bmct::run(std::shared_ptr<symex_target_equationt> &eq)
 {
+  // The table only needs to outlive the symex run it deduplicates, and
+  // belongs to this run alone
+  std::optional<irep_hashcons_scopet> hash_cons;
+  if (options.get_bool_option("hash-cons"))
+    hash_cons.emplace();
+
+  // Nodes built by this run are bump-allocated and released all together
+  std::optional<irep_arena_scopet> arena;
+  if (options.get_bool_option("symex-arena"))
+    arena.emplace();
+
+  // Value sets of this run number their objects in a table owned by symex
+  value_sett::numbering_scopet numbering(symex->value_set_numbering);
+
   symex->options.set_option("unwind", options.get_option("unwind"));
-  symex->setup_for_new_explore();
+  if (!incremental_symex || !symex->setup_for_resumed_explore())
+  {
+    symex->setup_for_new_explore();
+    if (incremental_symex)
+      reset_encoded_prefix();
+  }
 
   if (options.get_bool_option("schedule"))
     return run_thread(eq);
@@ -1083,6 +1348,16 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
       time2string(symex_stop - symex_start),
       eq->SSA_steps.size());
 
+    const goto_symext::merge_statst &merges = solver_result.merge_stats;
+    log_debug(
+      "symex-merge",
+      "Merged {} join point(s): compared {} of {} renamed variable(s), {} phi "
+      "assignment(s)",
+      merges.joins,
+      merges.phi_visited,
+      merges.phi_total,
+      merges.phi_assignments);
+
     if (options.get_bool_option("double-assign-check"))
       eq->check_for_duplicate_assigns();
 
@@ -1147,10 +1422,24 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
       return smt_convt::P_UNSATISFIABLE;
     }
 
+    if (incremental_symex)
+    {
+      if (!runtime_solver)
+        runtime_solver =
+          std::unique_ptr<smt_convt>(create_solver("", ns, options));
+
+      return run_incremental_decision_procedure(*eq);
+    }
+
+    if (
+      !options.get_option("portfolio").empty() &&
+      !options.get_bool_option("smt-during-symex") &&
+      !options.get_bool_option("multi-property"))
+      return run_portfolio(eq);
+
     if (!options.get_bool_option("smt-during-symex"))
     {
-      runtime_solver =
-        std::unique_ptr<smt_convt>(create_solver("", ns, options));
+      runtime_solver = std::unique_ptr<smt_convt>(create_formula_solver(*eq));
     }
 
     if (
@@ -1246,6 +1535,87 @@ int bmct::ltl_run_thread(symex_target_equationt &equation) const
   return ltl_res_good;
 }
 
+/* Estimates the solving cost of every claim as the number of active steps
+ * preceding it. Nothing after the claim survives claim_slicer, so this bounds
+ * the size of the sliced formula. Claims are numbered from 1 in the same way
+ * as claim_slicer does. */
+static std::vector<size_t>
+estimate_claim_costs(const symex_target_equationt &eq, size_t claims)
+{
+  std::vector<size_t> costs(claims + 1, 0);
+  size_t active_steps = 0;
+  size_t counter = 1;
+  for (const auto &step : eq.SSA_steps)
+  {
+    if (step.is_assert() && counter <= claims)
+      costs[counter++] = active_steps;
+    if (!step.ignore)
+      active_steps++;
+  }
+  return costs;
+}
+
+/* Builds the trace of a single claim that was checked on top of an encoding
+ * of every claim: all other assertions are kept out of the trace, as the
+ * claim slicer would have done. */
+static void build_claim_goto_trace(
+  symex_target_equationt &eq,
+  const symex_target_equationt::SSA_stept &claim,
+  smt_convt &smt_conv,
+  goto_tracet &goto_trace,
+  bool is_compact_trace)
+{
+  smt_astt false_val = smt_conv.convert_ast(gen_false_expr());
+  std::vector<std::pair<symex_target_equationt::SSA_stept *, smt_astt>> hidden;
+  for (auto &step : eq.SSA_steps)
+    if (step.is_assert() && &step != &claim)
+    {
+      hidden.emplace_back(&step, step.guard_ast);
+      step.guard_ast = false_val;
+    }
+
+  build_goto_trace(eq, smt_conv, goto_trace, is_compact_trace);
+
+  for (auto &[step, guard_ast] : hidden)
+    step->guard_ast = guard_ast;
+}
+
+/// Everything besides the formula that a cached claim result depends on
+static std::string claim_cache_salt(const optionst &options)
+{
+  // Options that only change how results are reported or scheduled
+  static const std::set<std::string> ignored = {
+    "ai-iterations",
+    "claim-result-cache",
+    "color",
+    "file-output",
+    "generate-testcase",
+    "interval-analysis-jobs",
+    "keep-alive-interval",
+    "memlimit",
+    "multi-fail-fast",
+    "output",
+    "parallel-solving",
+    "parallel-solving-jobs",
+    "parse-jobs",
+    "pch-cache",
+    "quiet",
+    "result-only",
+    "timeout",
+    "tu-cache",
+    "verbosity",
+    "witness-output",
+    "witness-output-yaml"};
+
+  std::ostringstream salt;
+  salt << "ESBMC " << ESBMC_VERSION << "\n";
+  for (const auto &[name, value] : options.option_map)
+    if (!ignored.count(name))
+      salt << name << "=" << value << "\n";
+
+  return salt.str();
+}
+
 smt_convt::resultt bmct::multi_property_check(
   const symex_target_equationt &eq,
   size_t remaining_claims,
@@ -1260,7 +1630,7 @@ smt_convt::resultt bmct::multi_property_check(
   smt_convt::resultt final_result = smt_convt::P_UNSATISFIABLE;
   std::mutex result_mutex;
   std::atomic<size_t> ce_counter{0};
-  std::unordered_set<size_t> jobs;
+  std::vector<size_t> jobs;
 
   // Add summary tracking
   SimpleSummary summary;
@@ -1315,9 +1685,82 @@ smt_convt::resultt bmct::multi_property_check(
   // For color output
   bool is_color = options.get_bool_option("color");
 
-  // TODO: This is the place to check a cache
+  // For parallel-solving
+  const bool is_parallel = options.get_bool_option("parallel-solving");
+  const std::string parallel_jobs = options.get_option("parallel-solving-jobs");
+  const int n_workers = !parallel_jobs.empty() ? stoi(parallel_jobs) : 0;
+
+  if (n_workers < 0)
+  {
+    log_error("the value of parallel-solving-jobs should be non-negative!");
+    abort();
+  }
+
+  // For multi-property-incremental: the equation is encoded once into a
+  // single solver, and every claim is then checked in its own context on top
+  // of that encoding. Claims share the solver, so they are checked one by one
+  const bool is_incremental =
+    options.get_bool_option("multi-property-incremental");
+  std::unique_ptr<smt_convt> shared_solver;
+  std::optional<symex_target_equationt> shared_eq;
+  std::vector<symex_target_equationt::SSA_stepst::iterator> shared_claims;
+
+  if (is_incremental)
+  {
+    if (is_parallel)
+      log_warning(
+        "multi-property-incremental checks claims in a single solver "
+        "context, ignoring parallel-solving");
+
+    shared_eq.emplace(eq);
+    for (auto it = shared_eq->SSA_steps.begin();
+         it != shared_eq->SSA_steps.end();
+         it++)
+      if (it->is_assert())
+        shared_claims.push_back(it);
+
+    shared_solver = std::unique_ptr<smt_convt>(create_solver("", ns, options));
+    generate_smt_from_equation(*shared_solver, *shared_eq, false);
+  }
+
+  // With smt-during-symex, every claim is solved in runtime_solver, which
+  // holds the encoding; converters can't be shared between threads
+  const bool is_shared_solver =
+    is_incremental || options.get_bool_option("smt-during-symex");
+  if (is_parallel && !is_incremental && is_shared_solver)
+    log_warning(
+      "smt-during-symex checks claims in a single solver, ignoring "
+      "parallel-solving");
+
+  bounded_worker_poolt pool(is_parallel && !is_shared_solver ? n_workers : 1);
+
+  // For claim-result-cache: claims proven by an earlier run on a
+  // byte-identical formula are not handed to the solver again
+  std::optional<claim_result_cachet> result_cache;
+  std::atomic<size_t> cache_hits{0};
+  const std::string cache_path = options.get_option("claim-result-cache");
+  if (!cache_path.empty())
+  {
+    if (is_incremental)
+      log_warning(
+        "multi-property-incremental does not slice claims, ignoring "
+        "claim-result-cache");
+    else
+      result_cache.emplace(cache_path, claim_cache_salt(options));
+  }
+
   for (size_t i = 1; i <= remaining_claims; i++)
-    jobs.emplace(i);
+    jobs.push_back(i);
+
+  // Hand out the most expensive claims first, so that a long claim is not
+  // left to run alone at the end while the other workers sit idle
+  if (is_parallel)
+  {
+    std::vector<size_t> costs = estimate_claim_costs(eq, remaining_claims);
+    std::stable_sort(jobs.begin(), jobs.end(), [&costs](size_t a, size_t b) {
+      return costs[a] > costs[b];
+    });
+  }
 
   /* This is a JOB that will:
    * 1. Generate a solver instance for a specific claim (@parameter i)
@@ -1356,19 +1799,26 @@ smt_convt::resultt bmct::multi_property_check(
                        &fc,
                        &is,
                        &is_color,
+                       &pool,
+                       &is_incremental,
+                       &shared_solver,
+                       &shared_eq,
+                       &shared_claims,
+                       &result_cache,
+                       &cache_hits,
                        &runtime_solver](const size_t &i) {
     //"multi-fail-fast n": stop after first n SATs found.
     if (is_fail_fast && fail_fast_cnt >= fail_fast_limit)
       return;
 
-    // Since this is just a copy, we probably don't need a lock
-    symex_target_equationt local_eq = eq;
-
-    // Set up the current claim and disable slice info output
+    // Set up the current claim and disable slice info output.
+    // The shared equation is never modified: the claim only records which
+    // of its steps are ignored, so no lock is needed
     bool is_goto_cov =
       is_assert_cov || is_cond_cov || is_branch_cov || is_branch_func_cov;
     claim_slicer claim(i, false, is_goto_cov, ns);
-    claim.run(local_eq.SSA_steps);
+    std::vector<bool> claim_ignore;
+    claim.run(eq.SSA_steps, claim_ignore);
 
     // Drop claims that verified to be failed
     // we use the "comment + location" to distinguish each claim
@@ -1388,11 +1838,11 @@ smt_convt::resultt bmct::multi_property_check(
       reached_mul_claims.emplace(claim_sig);
     }
 
+    bool is_cleared = false;
     if (verified_claims.count(claim.claim_cstr))
     {
-      clear_verified_claims_in_ssa(local_eq, claim, is_goto_cov);
       clear_verified_claims_in_goto(claim, is_goto_cov);
-      is_verified = true;
+      is_verified = is_cleared = true;
     }
 
     // skip if we have already verified
@@ -1402,12 +1852,35 @@ smt_convt::resultt bmct::multi_property_check(
       return;
     }
 
-    // Slice
-    if (!options.get_bool_option("no-slice"))
+    const bool is_sliced =
+      !is_incremental && !options.get_bool_option("no-slice");
+    std::optional<symex_target_equationt> sliced_eq;
+    if (is_cleared && !is_incremental)
     {
-      symex_slicet slicer(options);
-      slicer.run(local_eq.SSA_steps);
+      // Verified claims are cleared before slicing, so that the slicer
+      // doesn't keep what only their conditions depend on. This needs a
+      // copy of the steps the claim slicer kept.
+      sliced_eq.emplace(eq.project(claim_ignore));
+      clear_verified_claims_in_ssa(*sliced_eq, claim, is_goto_cov);
+      if (is_sliced)
+      {
+        symex_slicet slicer(options);
+        slicer.run(sliced_eq->SSA_steps);
+      }
     }
+    else if (!is_incremental)
+    {
+      // Slice the shared equation, and only copy the steps that survived
+      if (is_sliced)
+      {
+        symex_slicet slicer(options);
+        slicer.run(eq.SSA_steps, claim_ignore);
+      }
+      sliced_eq.emplace(eq.project(claim_ignore));
+    }
+
+    // Claims checked on top of the shared encoding use it as it is
+    symex_target_equationt &local_eq = is_incremental ? *shared_eq : *sliced_eq;
 
     if (options.get_bool_option("ssa-features-dump"))
     {
@@ -1415,28 +1888,61 @@ smt_convt::resultt bmct::multi_property_check(
       features.run(local_eq.SSA_steps);
     }
 
+    std::string cache_key;
+    bool is_cached = false;
+    if (result_cache)
+    {
+      cache_key = result_cache->key(local_eq);
+      is_cached = result_cache->is_proven(cache_key);
+    }
+
     // Initialize a solver
     smt_convt *solver_ptr = &runtime_solver;
     std::unique_ptr<smt_convt> new_solver;
-    if (!options.get_bool_option("smt-during-symex"))
+    if (is_cached)
+      log_status(
+        "Claim '{}' was proven on this formula before, skipping the solver",
+        claim.claim_cstr);
+    else
     {
-      new_solver = std::unique_ptr<smt_convt>(create_solver("", ns, options));
-      solver_ptr = new_solver.get();
-    }
+      if (is_incremental)
+        solver_ptr = shared_solver.get();
+      else if (!options.get_bool_option("smt-during-symex"))
+      {
+        new_solver =
+          std::unique_ptr<smt_convt>(create_formula_solver(local_eq));
+        solver_ptr = new_solver.get();
+      }
 
-    // Store solver name initially but not again
-    std::call_once(summary.solver_name_flag, [&]() {
-      summary.solver_name = solver_ptr->solver_text();
-    });
-    log_status(
-      "Solving claim '{}' with solver {}",
-      claim.claim_cstr,
-      solver_ptr->solver_text());
+      // Store solver name initially but not again
+      std::call_once(summary.solver_name_flag, [&]() {
+        summary.solver_name = solver_ptr->solver_text();
+      });
+      log_status(
+        "Solving claim '{}' with solver {}",
+        claim.claim_cstr,
+        solver_ptr->solver_text());
+    }
 
     // Save current instance with timing
     fine_timet solve_start = current_time();
-    smt_convt::resultt solver_result =
-      run_decision_procedure(*solver_ptr, local_eq);
+    smt_convt::resultt solver_result;
+    const symex_target_equationt::SSA_stept *claim_step = nullptr;
+    if (is_cached)
+    {
+      ++cache_hits;
+      solver_result = smt_convt::P_UNSATISFIABLE;
+    }
+    else if (is_incremental)
+    {
+      // The context is popped once the claim's trace has been built
+      claim_step = &*shared_claims.at(i - 1);
+      solver_ptr->push_ctx();
+      solver_ptr->assert_ast(solver_ptr->invert_ast(claim_step->cond_ast));
+      solver_result = solver_ptr->dec_solve_refined();
+    }
+    else
+      solver_result = run_decision_procedure(*solver_ptr, local_eq);
     fine_timet solve_stop = current_time();
 
     // Show colored result after solving
@@ -1481,7 +1987,11 @@ smt_convt::resultt bmct::multi_property_check(
         is_compact_trace = false;
 
       goto_tracet goto_trace;
-      build_goto_trace(local_eq, *solver_ptr, goto_trace, is_compact_trace);
+      if (is_incremental)
+        build_claim_goto_trace(
+          local_eq, *claim_step, *solver_ptr, goto_trace, is_compact_trace);
+      else
+        build_goto_trace(local_eq, *solver_ptr, goto_trace, is_compact_trace);
 
       // Store claim signature
       if (is_assert_cov)
@@ -1529,8 +2039,11 @@ smt_convt::resultt bmct::multi_property_check(
         final_result = solver_result;
       }
 
-      // Update fail-fast-counter
+      // Update fail-fast-counter, and stop handing out claims once the
+      // limit is reached
       fail_fast_cnt++;
+      if (is_fail_fast && fail_fast_cnt >= fail_fast_limit)
+        pool.cancel();
 
       // for kind && incr: remove verified claims
       // whenever we find a property violation, we remove the claim
@@ -1541,6 +2054,10 @@ smt_convt::resultt bmct::multi_property_check(
       }
     }
     else if (solver_result == smt_convt::P_UNSATISFIABLE)
+    {
+      if (result_cache && !is_cached)
+        result_cache->record_proven(cache_key);
+
       // for kind && incr: remove verified claims
       // when we find a property proven correct in
       // either forward condition or inductive step
@@ -1549,36 +2066,30 @@ smt_convt::resultt bmct::multi_property_check(
         clear_verified_claims_in_ssa(local_eq, claim, is_goto_cov);
         clear_verified_claims_in_goto(claim, is_goto_cov);
       }
+    }
+
+    // Drop this claim from the shared solver before checking the next one
+    if (is_incremental)
+      solver_ptr->pop_ctx();
   };
 
-  // PARALLEL
-  if (options.get_bool_option("parallel-solving"))
+  // PARALLEL: at most one claim per worker is alive at any time, which keeps
+  // the number of solver instances (and the memory they hold) bounded
+  if (is_parallel)
+    log_status(
+      "Solving {} claims with {} worker threads", jobs.size(), pool.size());
+
+  // SEQUENTIAL runs through the same pool with a single worker
+  pool.run(jobs, job_function);
+
+  if (result_cache)
   {
-    /* NOTE: I would love to use std::for_each here, but it is not giving
-       * the result I would expect. My guess is either compiler version
-       * or some magic flag that we are not using.
-       *
-       * Nevertheless, we can achieve the same results by just creating
-       * threads.
-       */
-
-    // TODO: Running everything in parallel might be a bad idea.
-    //       Should we also add a thread pool?
-    std::vector<std::thread> parallel_jobs;
-    for (const auto &i : jobs)
-      parallel_jobs.push_back(std::thread(job_function, i));
-
-    // Main driver
-    for (auto &t : parallel_jobs)
-    {
-      t.join();
-    }
-    // We could remove joined jobs from the parallel_jobs vector.
-    // However, its probably not worth for small vectors.
+    result_cache->save();
+    log_status(
+      "Claim result cache: {} of {} claim(s) answered without the solver",
+      cache_hits.load(),
+      jobs.size());
   }
-  // SEQUENTIAL
-  else
-    std::for_each(std::begin(jobs), std::end(jobs), job_function);
 
   // show summary
   report_simple_summary(summary);
@@ -1,6 +1,7 @@
 #ifndef CPROVER_CBMC_BMC_H
 #define CPROVER_CBMC_BMC_H
 
+#include <esbmc/auto_solver.h>
 #include <goto-programs/goto_coverage.h>
 #include <goto-symex/slice.h>
 #include <goto-symex/reachability_tree.h>
@@ -38,6 +39,16 @@ public:
   virtual smt_convt::resultt run(std::shared_ptr<symex_target_equationt> &eq);
   virtual ~bmct() = default;
 
+  /**
+   * @brief Reuse symex and solver work between runs with increasing bounds
+   *
+   * Each run keeps the symex state at the point where the unwinding bound is
+   * first hit, together with the encoding of the equation built until then.
+   * The next run (with a larger "unwind" option) resumes symex from there and
+   * only encodes the new suffix, in a fresh solver context.
+   */
+  void set_incremental_symex(bool enable);
+
 protected:
   const contextt &context;
   namespacet ns;
@@ -50,6 +61,45 @@ protected:
   virtual smt_convt::resultt
   run_decision_procedure(smt_convt &smt_conv, symex_target_equationt &eq) const;
 
+  /** Starts reporting that the solver is still running, if enabled */
+  void start_keep_alive() const;
+
+  /** Dumps the formula encoded in `smt_conv` if asked to, then solves it
+   *  unless only the formula was asked for */
+  smt_convt::resultt solve_encoded(smt_convt &smt_conv) const;
+
+  /** Set with --auto-solver */
+  std::unique_ptr<auto_solvert> auto_solver;
+
+  /** A solver for `eq`, the one picked by --auto-solver if enabled */
+  smt_convt *create_formula_solver(const symex_target_equationt &eq) const;
+
+  // for --portfolio
+  /** How often each solver answered first */
+  std::map<std::string, unsigned> portfolio_wins;
+
+  smt_convt::resultt run_portfolio(std::shared_ptr<symex_target_equationt> &eq);
+  void report_portfolio_wins() const;
+
+  // for incremental-symex
+  struct encoded_stept
+  {
+    smt_astt guard_ast;
+    smt_astt cond_ast;
+    std::list<expr2tc> converted_output_args;
+  };
+
+  bool incremental_symex = false;
+  bool suffix_ctx_pushed = false;
+  /** Encoding of the SSA steps shared by every run, kept in runtime_solver */
+  std::vector<encoded_stept> encoded_prefix;
+  smt_astt prefix_assumpt_ast = nullptr;
+  smt_convt::ast_vec prefix_assertions;
+
+  void reset_encoded_prefix();
+  smt_convt::resultt
+  run_incremental_decision_procedure(symex_target_equationt &eq);
+
   virtual void show_program(const symex_target_equationt &eq);
   virtual void report_success();
   virtual void report_failure();
@@ -85,7 +135,8 @@ protected:
 
   void generate_smt_from_equation(
     smt_convt &smt_conv,
-    symex_target_equationt &eq) const;
+    symex_target_equationt &eq,
+    bool assert_claims = true) const;
 
   // for multi-property
   void clear_verified_claims_in_ssa(
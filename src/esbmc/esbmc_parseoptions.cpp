@@ -44,9 +44,13 @@ extern "C"
 #include <goto-programs/assign_params_as_non_det.h>
 #include <goto2c/goto2c.h>
 #include <util/irep.h>
+#include <util/migrate.h>
 #include <langapi/languages.h>
 #include <langapi/mode.h>
 #include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <pointer-analysis/goto_program_dereference.h>
 #include <pointer-analysis/show_value_sets.h>
 #include <pointer-analysis/value_set_analysis.h>
@@ -78,20 +82,243 @@ static std::string_view esbmc_version_string()
   return {buildidstring_buf, buildidstring_buf_size};
 }
 
-enum PROCESS_TYPE
+enum k_induction_stept
 {
   BASE_CASE,
   FORWARD_CONDITION,
-  INDUCTIVE_STEP,
-  PARENT
+  INDUCTIVE_STEP
 };
 
-struct resultt
+// Facts learned by the parallel k-induction workers. Every worker publishes
+// its results here and consults them before each bound, so that no worker
+// keeps checking bounds that can no longer change the outcome.
+class k_induction_boardt
 {
-  PROCESS_TYPE type;
-  uint64_t k;
+public:
+  // The base case holds for k, hence for every smaller bound as well
+  void base_case_holds(uint64_t k)
+  {
+    std::lock_guard lock(mutex);
+    bc_safe_k = std::max(bc_safe_k, k);
+    cond.notify_all();
+  }
+
+  void bug_found(uint64_t k)
+  {
+    std::lock_guard lock(mutex);
+    if (!bug_k || k < bug_k)
+      bug_k = k;
+    cond.notify_all();
+  }
+
+  // The forward condition or the inductive step holds for k
+  void proof_found(k_induction_stept step, uint64_t k)
+  {
+    std::lock_guard lock(mutex);
+    if (!proof_k || k < proof_k)
+    {
+      proof_k = k;
+      proof_step = step;
+    }
+    cond.notify_all();
+  }
+
+  void worker_finished(bool crashed)
+  {
+    std::lock_guard lock(mutex);
+    ++finished;
+    failed |= crashed;
+    cond.notify_all();
+  }
+
+  /// Whether a worker of `step` about to check `k` should give up instead
+  bool should_stop(k_induction_stept step, uint64_t k)
+  {
+    std::lock_guard lock(mutex);
+    if (is_decided() || failed)
+      return true;
+
+    // A proof for a smaller bound makes larger ones pointless
+    return step != BASE_CASE && proof_k && proof_k <= k;
+  }
+
+  /// Largest bound the base case still needs to reach
+  uint64_t base_case_limit(uint64_t max_k)
+  {
+    std::lock_guard lock(mutex);
+    return proof_k ? std::min(proof_k, max_k) : max_k;
+  }
+
+  bool base_case_known(uint64_t k)
+  {
+    std::lock_guard lock(mutex);
+    return k <= bc_safe_k;
+  }
+
+  bool all_finished(size_t workers)
+  {
+    std::lock_guard lock(mutex);
+    return finished == workers;
+  }
+
+  /// Blocks until the outcome is known or `workers` workers are finished
+  void wait(size_t workers)
+  {
+    std::unique_lock lock(mutex);
+    cond.wait(
+      lock, [&] { return is_decided() || failed || finished == workers; });
+  }
+
+  struct resultt
+  {
+    uint64_t bug_k;
+    uint64_t proof_k;
+    k_induction_stept proof_step;
+    uint64_t bc_safe_k;
+  };
+
+  resultt get_result()
+  {
+    std::lock_guard lock(mutex);
+    return {bug_k, proof_k, proof_step, bc_safe_k};
+  }
+
+protected:
+  bool is_decided() const
+  {
+    return bug_k || (proof_k && proof_k <= bc_safe_k);
+  }
+
+  // 0 stands for "not found"
+  uint64_t bug_k = 0;
+  uint64_t proof_k = 0;
+  k_induction_stept proof_step = FORWARD_CONDITION;
+  uint64_t bc_safe_k = 0;
+  bool failed = false;
+  size_t finished = 0;
+
+  std::mutex mutex;
+  std::condition_variable cond;
 };
 
+// Runs one parallel k-induction worker, which checks `step` for the bounds
+// first_k, first_k + stride, ... Symex adds symbols as it goes and claim
+// handling rewrites the GOTO program, so each worker works on its own copy
+// of both; the copies share their unchanged ireps with the originals.
+static void k_induction_worker(
+  k_induction_stept step,
+  uint64_t first_k,
+  uint64_t stride,
+  uint64_t max_k,
+  uint64_t max_inductive_step,
+  const optionst &cmd_options,
+  const goto_functionst &goto_functions,
+  const contextt &context,
+  k_induction_boardt &board)
+{
+  optionst options = cmd_options;
+  const char *name = "base case";
+  switch (step)
+  {
+  case BASE_CASE:
+    options.set_option("base-case", true);
+    options.set_option("forward-condition", false);
+    options.set_option("inductive-step", false);
+    options.set_option("no-unwinding-assertions", true);
+    options.set_option("partial-loops", false);
+    break;
+
+  case FORWARD_CONDITION:
+    name = "forward condition";
+    options.set_option("base-case", false);
+    options.set_option("forward-condition", true);
+    options.set_option("inductive-step", false);
+    options.set_option("no-unwinding-assertions", false);
+    options.set_option("partial-loops", false);
+    options.set_option("no-assertions", true);
+    break;
+
+  case INDUCTIVE_STEP:
+    name = "inductive step";
+    options.set_option("base-case", false);
+    options.set_option("forward-condition", false);
+    options.set_option("inductive-step", true);
+    options.set_option("no-unwinding-assertions", true);
+    options.set_option("partial-loops", true);
+    break;
+  }
+
+  contextt worker_context;
+  context.foreach_operand_in_order(
+    [&worker_context](const symbolt &s) { worker_context.add(s); });
+  namespacet worker_ns(worker_context);
+  migrate_namespace_lookup = &worker_ns;
+  goto_functionst worker_functions = goto_functions;
+
+  bool crashed = false;
+  for (uint64_t k_step = first_k; k_step <= max_k; k_step += stride)
+  {
+    if (board.should_stop(step, k_step))
+      break;
+
+    if (step == BASE_CASE)
+    {
+      // Once a proof is known, its bound is the only one left to check
+      k_step = std::min(k_step, board.base_case_limit(max_k));
+      if (board.base_case_known(k_step))
+        continue;
+    }
+
+    if (
+      (step == FORWARD_CONDITION &&
+       options.get_bool_option("disable-forward-condition")) ||
+      (step == INDUCTIVE_STEP &&
+       (options.get_bool_option("disable-inductive-step") ||
+        k_step > max_inductive_step)))
+      break;
+
+    options.set_option("unwind", integer2string(k_step));
+    bmct bmc(worker_functions, options, worker_context);
+
+    log_progress("Checking {}, k = {:d}", name, k_step);
+
+    smt_convt::resultt res = smt_convt::P_ERROR;
+    try
+    {
+      res = bmc.start_bmc();
+    }
+    catch (...)
+    {
+    }
+
+    if (res == smt_convt::P_ERROR)
+    {
+      log_warning("{} worker failed (k = {:d})", name, k_step);
+      crashed = true;
+      break;
+    }
+
+    if (step == BASE_CASE)
+    {
+      if (res == smt_convt::P_SATISFIABLE)
+      {
+        board.bug_found(k_step);
+        break;
+      }
+
+      if (res == smt_convt::P_UNSATISFIABLE)
+        board.base_case_holds(k_step);
+    }
+    else if (res == smt_convt::P_UNSATISFIABLE)
+    {
+      board.proof_found(step, k_step);
+      break;
+    }
+  }
+
+  board.worker_finished(crashed);
+}
+
 #ifndef _WIN32
 void timeout_handler(int)
 {
@@ -328,6 +555,14 @@ void esbmc_parseoptionst::get_command_line_options(optionst &options)
   else
     options.set_option("context-bound", -1);
 
+  if (
+    cmdline.isset("parse-jobs") &&
+    strtol(cmdline.getval("parse-jobs"), nullptr, 10) < 0)
+  {
+    log_error("the value of parse-jobs should be non-negative!");
+    abort();
+  }
+
   if (cmdline.isset("deadlock-check"))
   {
     options.set_option("deadlock-check", true);
@@ -473,8 +708,12 @@ void esbmc_parseoptionst::get_command_line_options(optionst &options)
   }
 #endif
 
-  // parallel solving activates "--multi-property"
-  if (cmdline.isset("parallel-solving"))
+  // parallel and incremental solving, as well as caching per-claim results,
+  // activate "--multi-property"
+  if (
+    cmdline.isset("parallel-solving") ||
+    cmdline.isset("multi-property-incremental") ||
+    cmdline.isset("claim-result-cache"))
   {
     options.set_option("base-case", true);
     options.set_option("multi-property", true);
@@ -486,6 +725,21 @@ void esbmc_parseoptionst::get_command_line_options(optionst &options)
     options.set_option("base-case", true);
   }
 
+  // Resuming the base case needs a single equation built by dfs symex
+  if (
+    cmdline.isset("incremental-symex") &&
+    (options.get_bool_option("multi-property") ||
+     cmdline.isset("smt-during-symex") || cmdline.isset("schedule") ||
+     cmdline.isset("state-hashing") || cmdline.isset("ltl") ||
+     cmdline.isset("bidirectional") || cmdline.isset("k-induction-parallel")))
+  {
+    log_warning(
+      "--incremental-symex is not supported with multi-property, "
+      "smt-during-symex, schedule, state-hashing, ltl, bidirectional or "
+      "k-induction-parallel; disabling it");
+    options.set_option("incremental-symex", false);
+  }
+
   /* compatibility: --cvc maps to --cvc4 */
   if (cmdline.isset("cvc"))
     options.set_option("cvc4", true);
@@ -638,90 +892,27 @@ int esbmc_parseoptionst::doit()
   return do_bmc(bmc);
 }
 
-// This is the parallel version of k-induction algorithm.
-// This is an old implementation and should be revisited sometime in the
-// future.
+// This is the parallel version of k-induction algorithm. Base case, forward
+// condition and inductive step run on worker threads that share the GOTO
+// program and exchange what they learn through a k_induction_boardt.
 int esbmc_parseoptionst::doit_k_induction_parallel()
 {
-#ifdef _WIN32
-  log_error("Windows does not support parallel kind");
-  abort();
-#else
-  // Pipes for communication between processes
-  int forward_pipe[2], backward_pipe[2];
-
-  // Process type
-  PROCESS_TYPE process_type = PARENT;
-
-  if (pipe(forward_pipe))
-  {
-    log_status("\nPipe Creation Failed, giving up.");
-    _exit(1);
-  }
-
-  if (pipe(backward_pipe))
-  {
-    log_status("\nPipe Creation Failed, giving up.");
-    _exit(1);
-  }
-
-  /* Set file descriptor non-blocking */
-  fcntl(
-    backward_pipe[0], F_SETFL, fcntl(backward_pipe[0], F_GETFL) | O_NONBLOCK);
-
-  pid_t children_pid[3];
-  short num_p = 0;
-
-  // We need to fork 3 times: one for each step
-  for (unsigned p = 0; p < 3; ++p)
-  {
-    pid_t pid = fork();
-
-    if (pid == -1)
-    {
-      log_status("\nFork Failed, giving up.");
-      _exit(1);
-    }
-
-    // Child process
-    if (!pid)
-    {
-      process_type = PROCESS_TYPE(p);
-      break;
-    }
-    // Parent process
+  optionst options;
+  get_command_line_options(options);
 
-    children_pid[p] = pid;
-    ++num_p;
-  }
+  // Generate goto functions and set claims
+  if (get_goto_program(options, goto_functions))
+    return 6;
 
-  if (process_type == PARENT && num_p != 3)
+  if (cmdline.isset("show-claims"))
   {
-    log_error("Child processes were not created sucessfully.");
-    abort();
+    const namespacet ns(context);
+    show_claims(ns, goto_functions);
+    return 0;
   }
 
-  optionst options;
-
-  if (process_type != PARENT)
-  {
-    // Get full set of options
-    get_command_line_options(options);
-
-    // Generate goto functions and set claims
-    if (get_goto_program(options, goto_functions))
-      return 6;
-
-    if (cmdline.isset("show-claims"))
-    {
-      const namespacet ns(context);
-      show_claims(ns, goto_functions);
-      return 0;
-    }
-
-    if (set_claims(goto_functions))
-      return 7;
-  }
+  if (set_claims(goto_functions))
+    return 7;
 
   // Get max number of iterations
   uint64_t max_k_step = cmdline.isset("unlimited-k-steps")
@@ -741,476 +932,83 @@ int esbmc_parseoptionst::doit_k_induction_parallel()
     abort();
   }
 
-  // All processes were created successfully
-  switch (process_type)
-  {
-  case PARENT:
-  {
-    // Communication to child processes
-    close(forward_pipe[1]);
-    close(backward_pipe[0]);
-
-    struct resultt a_result;
-    bool bc_finished = false, fc_finished = false, is_finished = false;
-    uint64_t bc_solution = max_k_step, fc_solution = max_k_step,
-             is_solution = max_k_step;
-
-    // Keep reading until we find an answer
-    while (!(bc_finished && fc_finished && is_finished))
-    {
-      // Perform read and interpret the number of bytes read
-      int read_size = read(forward_pipe[0], &a_result, sizeof(resultt));
-      if (read_size != sizeof(resultt))
-      {
-        if (read_size == 0)
-        {
-          // Client hung up; continue on, but don't interpret the result.
-          ;
-        }
-        else
-        {
-          // Invalid size read.
-          log_error("Short read communicating with kinduction children");
-          log_error("Size {}, expected {}", read_size, sizeof(resultt));
-          abort();
-        }
-      }
+  uint64_t max_inductive_step =
+    strtoul(cmdline.getval("max-inductive-step"), nullptr, 10);
 
-      // Eventually the parent process will check if the child process is alive
-
-      // Check base case process
-      if (!bc_finished)
-      {
-        int status;
-        pid_t result = waitpid(children_pid[0], &status, WNOHANG);
-        if (result == 0)
-        {
-          // Child still alive
-        }
-        else if (result == -1)
-        {
-          // Error
-        }
-        else
-        {
-          log_warning("base case process crashed.");
-          bc_finished = fc_finished = is_finished = true;
-        }
-      }
-
-      // Check forward condition process
-      if (!fc_finished)
-      {
-        int status;
-        pid_t result = waitpid(children_pid[1], &status, WNOHANG);
-        if (result == 0)
-        {
-          // Child still alive
-        }
-        else if (result == -1)
-        {
-          // Error
-        }
-        else
-        {
-          log_warning("forward condition process crashed.");
-          fc_finished = bc_finished = is_finished = true;
-        }
-      }
-
-      // Check inductive step process
-      if (!is_finished)
-      {
-        int status;
-        pid_t result = waitpid(children_pid[2], &status, WNOHANG);
-        if (result == 0)
-        {
-          // Child still alive
-        }
-        else if (result == -1)
-        {
-          // Error
-        }
-        else
-        {
-          log_warning("inductive step process crashed.");
-          is_finished = bc_finished = fc_finished = true;
-        }
-      }
-
-      switch (a_result.type)
-      {
-      case BASE_CASE:
-        bc_finished = true;
-        bc_solution = a_result.k;
-        break;
-
-      case FORWARD_CONDITION:
-        fc_finished = true;
-        fc_solution = a_result.k;
-        break;
-
-      case INDUCTIVE_STEP:
-        is_finished = true;
-        is_solution = a_result.k;
-        break;
-
-      default:
-        log_error("Message from unrecognized k-induction child process");
-        abort();
-      }
-
-      // If either the base case found a bug or the forward condition
-      // finds a solution, present the result
-      if (bc_finished && (bc_solution != 0) && (bc_solution != max_k_step))
-        break;
-
-      // If the either the forward condition or inductive step finds a
-      // solution, first check if base case couldn't find a bug in that code,
-      // if there is no bug, inductive step can present the result
-      if (fc_finished && (fc_solution != 0) && (fc_solution != max_k_step))
-      {
-        // If base case finished, then we can present the result
-        if (bc_finished)
-          break;
-
-        // Otherwise, kill the inductive step process
-        kill(children_pid[2], SIGKILL);
-
-        // And ask base case for a solution
-
-        // Struct to keep the result
-        struct resultt r = {process_type, 0};
-
-        r.k = fc_solution;
-
-        // Write result
-        auto const len = write(backward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
-      }
-
-      if (is_finished && (is_solution != 0) && (is_solution != max_k_step))
-      {
-        // If base case finished, then we can present the result
-        if (bc_finished)
-          break;
-
-        // Otherwise, kill the forward condition process
-        kill(children_pid[1], SIGKILL);
-
-        // And ask base case for a solution
-
-        // Struct to keep the result
-        struct resultt r = {process_type, 0};
-
-        r.k = is_solution;
-
-        // Write result
-        auto const len = write(backward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
-      }
-    }
-
-    for (int i : children_pid)
-      kill(i, SIGKILL);
-
-    // Check if a solution was found by the base case
-    if (bc_finished && (bc_solution != 0) && (bc_solution != max_k_step))
-    {
-      log_result(
-        "\nBug found by the base case (k = {})\nVERIFICATION FAILED",
-        bc_solution);
-      return true;
-    }
-
-    // Check if a solution was found by the forward condition
-    if (fc_finished && (fc_solution != 0) && (fc_solution != max_k_step))
-    {
-      // We should only present the result if the base case finished
-      // and haven't crashed (if it crashed, bc_solution will be UINT_MAX
-      if (bc_finished && (bc_solution != max_k_step))
-      {
-        log_success(
-          "\nSolution found by the forward condition; "
-          "all states are reachable (k = {:d})\n"
-          "VERIFICATION SUCCESSFUL",
-          fc_solution);
-        return false;
-      }
-    }
-
-    // Check if a solution was found by the inductive step
-    if (is_finished && (is_solution != 0) && (is_solution != max_k_step))
-    {
-      // We should only present the result if the base case finished
-      // and haven't crashed (if it crashed, bc_solution will be UINT_MAX
-      if (bc_finished && (bc_solution != max_k_step))
-      {
-        log_success(
-          "\nSolution found by the inductive step "
-          "(k = {:d})\n"
-          "VERIFICATION SUCCESSFUL",
-          is_solution);
-        return false;
-      }
-    }
-
-    // Couldn't find a bug or a proof for the current depth
-    log_fail("\nVERIFICATION UNKNOWN");
-    return false;
-  }
-
-  case BASE_CASE:
+  // Number of workers for each step, worker i of a step checks every
+  // n-th bound starting from the i-th one
+  const std::string k_workers = options.get_option("k-induction-workers");
+  const int n_workers = !k_workers.empty() ? stoi(k_workers) : 1;
+  if (n_workers <= 0)
   {
-    // Set that we are running base case
-    options.set_option("base-case", true);
-    options.set_option("forward-condition", false);
-    options.set_option("inductive-step", false);
-
-    options.set_option("no-unwinding-assertions", true);
-    options.set_option("partial-loops", false);
-
-    // Start communication to the parent process
-    close(forward_pipe[0]);
-    close(backward_pipe[1]);
-
-    // Struct to keep the result
-    struct resultt r = {process_type, 0};
-
-    // Run bmc and only send results in two occasions:
-    // 1. A bug was found, we send the step where it was found
-    // 2. It couldn't find a bug
-    for (uint64_t k_step = k_step_base; k_step <= max_k_step;
-         k_step += k_step_inc)
-    {
-      bmct bmc(goto_functions, options, context);
-      bmc.options.set_option("unwind", integer2string(k_step));
-
-      log_progress("Checking base case, k = {:d}\n", k_step);
-
-      // If an exception was thrown, we should abort the process
-      int res = smt_convt::P_ERROR;
-      try
-      {
-        res = do_bmc(bmc);
-      }
-      catch (...)
-      {
-        break;
-      }
-
-      // Send information to parent if no bug was found
-      if (res == smt_convt::P_SATISFIABLE)
-      {
-        r.k = k_step;
-
-        // Write result
-        auto const len = write(forward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
-
-        log_status("Base case process finished (bug found).\n");
-        return true;
-      }
-
-      // Check if the parent process is asking questions
-
-      // Perform read and interpret the number of bytes read
-      struct resultt a_result;
-      int read_size = read(backward_pipe[0], &a_result, sizeof(resultt));
-      if (read_size != sizeof(resultt))
-      {
-        if (read_size == 0)
-        {
-          // Client hung up; continue on, but don't interpret the result.
-          continue;
-        }
-        if (read_size == -1 && errno == EAGAIN)
-        {
-          // No data available yet
-          continue;
-        }
-        else
-        {
-          // Invalid size read.
-          log_error("Short read communicating with kinduction parent");
-          log_error("Size {}, expected {}", read_size, sizeof(resultt));
-
-          abort();
-        }
-      }
-
-      // We only receive messages from the parent
-      assert(a_result.type == PARENT);
-
-      // If the value being asked is greater or equal the current step,
-      // then we can stop the base case. It can be equal, because we
-      // have just checked the current value of k
-      if (a_result.k < k_step)
-        break;
-
-      // Otherwise, we just need to check the base case for k = a_result.k
-      max_k_step = a_result.k + k_step_inc;
-    }
-
-    // Send information to parent that a bug was not found
-    r.k = 0;
-
-    auto const len = write(forward_pipe[1], &r, sizeof(r));
-    assert(len == sizeof(r) && "short write");
-    (void)len; //ndebug
-
-    log_status("Base case process finished (no bug found).\n");
-    return false;
+    log_error("the value of k-induction-workers should be positive!");
+    abort();
   }
 
-  case FORWARD_CONDITION:
+  k_induction_boardt board;
+  std::vector<std::thread> workers;
+  for (k_induction_stept step : {BASE_CASE, FORWARD_CONDITION, INDUCTIVE_STEP})
   {
-    // Set that we are running forward condition
-    options.set_option("base-case", false);
-    options.set_option("forward-condition", true);
-    options.set_option("inductive-step", false);
-
-    options.set_option("no-unwinding-assertions", false);
-    options.set_option("partial-loops", false);
-    options.set_option("no-assertions", true);
-
-    // Start communication to the parent process
-    close(forward_pipe[0]);
-    close(backward_pipe[1]);
-
-    // Struct to keep the result
-    struct resultt r = {process_type, 0};
-
-    // Run bmc and only send results in two occasions:
-    // 1. A proof was found, we send the step where it was found
-    // 2. It couldn't find a proof
-    for (uint64_t k_step = k_step_base + 1; k_step <= max_k_step;
-         k_step += k_step_inc)
-    {
-      bmct bmc(goto_functions, options, context);
-      bmc.options.set_option("unwind", integer2string(k_step));
-
-      log_status("Checking forward condition, k = {:d}", k_step);
-
-      // If an exception was thrown, we should abort the process
-      int res = smt_convt::P_ERROR;
-      try
-      {
-        res = do_bmc(bmc);
-      }
-      catch (...)
-      {
-        break;
-      }
-
-      if (options.get_bool_option("disable-forward-condition"))
-        break;
-
-      // Send information to parent if no bug was found
-      if (res == smt_convt::P_UNSATISFIABLE)
-      {
-        r.k = k_step;
-
-        // Write result
-        auto const len = write(forward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
-
-        log_status("Forward condition process finished (safety proven).");
-        return false;
-      }
-    }
-
-    // Send information to parent that it couldn't prove the code
-    r.k = 0;
+    uint64_t first_k = step == BASE_CASE ? k_step_base : k_step_base + 1;
+    for (int w = 0; w < n_workers; ++w)
+      workers.emplace_back(
+        k_induction_worker,
+        step,
+        first_k + w * k_step_inc,
+        n_workers * k_step_inc,
+        max_k_step,
+        max_inductive_step,
+        std::cref(options),
+        std::cref(goto_functions),
+        std::cref(context),
+        std::ref(board));
+  }
 
-    auto const len = write(forward_pipe[1], &r, sizeof(r));
-    assert(len == sizeof(r) && "short write");
-    (void)len; //ndebug
+  board.wait(workers.size());
+  k_induction_boardt::resultt result = board.get_result();
 
-    log_status("Forward condition process finished (safety not proven).");
-    return true;
+  int ret = 0;
+  if (result.bug_k)
+  {
+    log_result(
+      "\nBug found by the base case (k = {})\nVERIFICATION FAILED",
+      result.bug_k);
+    ret = 1;
+  }
+  else if (result.proof_k && result.proof_k <= result.bc_safe_k)
+  {
+    if (result.proof_step == FORWARD_CONDITION)
+      log_success(
+        "\nSolution found by the forward condition; "
+        "all states are reachable (k = {:d})\n"
+        "VERIFICATION SUCCESSFUL",
+        result.proof_k);
+    else
+      log_success(
+        "\nSolution found by the inductive step "
+        "(k = {:d})\n"
+        "VERIFICATION SUCCESSFUL",
+        result.proof_k);
   }
-
-  case INDUCTIVE_STEP:
+  else
   {
-    // Set that we are running inductive step
-    options.set_option("base-case", false);
-    options.set_option("forward-condition", false);
-    options.set_option("inductive-step", true);
-
-    options.set_option("no-unwinding-assertions", true);
-    options.set_option("partial-loops", true);
-
-    // Start communication to the parent process
-    close(forward_pipe[0]);
-    close(backward_pipe[1]);
-
-    // Struct to keep the result
-    struct resultt r = {process_type, 0};
-
-    // Run bmc and only send results in two occasions:
-    // 1. A proof was found, we send the step where it was found
-    // 2. It couldn't find a proof
-    for (uint64_t k_step = k_step_base + 1; k_step <= max_k_step;
-         k_step += k_step_inc)
-    {
-      bmct bmc(goto_functions, options, context);
-
-      bmc.options.set_option("unwind", integer2string(k_step));
-
-      log_status("Checking inductive step, k = {:d}", k_step);
-
-      // If an exception was thrown, we should abort the process
-      int res = smt_convt::P_ERROR;
-      try
-      {
-        res = do_bmc(bmc);
-      }
-      catch (...)
-      {
-        break;
-      }
-
-      if (options.get_bool_option("disable-inductive-step"))
-        break;
-
-      // Send information to parent if no bug was found
-      if (res == smt_convt::P_UNSATISFIABLE)
-      {
-        r.k = k_step;
-
-        // Write result
-        auto const len = write(forward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
-
-        log_status("Inductive process finished (safety proven).");
-        return false;
-      }
-    }
-
-    // Send information to parent that it couldn't prove the code
-    r.k = 0;
-
-    auto const len = write(forward_pipe[1], &r, sizeof(r));
-    assert(len == sizeof(r) && "short write");
-    (void)len; //ndebug
-
-    log_status("Inductive process finished (safety not proven).");
-    return true;
+    // Couldn't find a bug or a proof for the current depth
+    log_fail("\nVERIFICATION UNKNOWN");
   }
 
-  default:
-    assert(0 && "Unknown process type.");
+  if (!board.all_finished(workers.size()))
+  {
+    // The others may be stuck in a solver call that can't be interrupted;
+    // they have nothing left to contribute, so don't wait for them.
+    fflush(stdout);
+    fflush(stderr);
+    std::_Exit(ret);
   }
 
-#endif
+  for (auto &t : workers)
+    t.join();
 
-  return 0;
+  return ret;
 }
 
 // This method iteratively applies one of the verification strategies
@@ -1376,7 +1174,17 @@ tvt esbmc_parseoptionst::is_base_case_violated(
   options.set_option("partial-loops", false);
   options.set_option("unwind", integer2string(k_step));
 
-  bmct bmc(goto_functions, options, context);
+  // With --incremental-symex the same bmct is kept between bounds, so that it
+  // can pick up from where the previous bound stopped
+  std::unique_ptr<bmct> fresh_bmc;
+  if (!options.get_bool_option("incremental-symex"))
+    fresh_bmc = std::make_unique<bmct>(goto_functions, options, context);
+  else if (!base_case_bmc)
+  {
+    base_case_bmc = std::make_unique<bmct>(goto_functions, options, context);
+    base_case_bmc->set_incremental_symex(true);
+  }
+  bmct &bmc = fresh_bmc ? *fresh_bmc : *base_case_bmc;
 
   log_progress("Checking base case, k = {:d}", k_step);
   switch (do_bmc(bmc))
@@ -1733,16 +1541,11 @@ bool esbmc_parseoptionst::read_goto_binary(goto_functionst &goto_functions)
 {
   log_progress("Reading GOTO program from file");
   goto_binary_reader goto_reader;
-  for (const auto &arg : cmdline.args)
-  {
-    if (goto_reader.read_goto_binary(arg, context, goto_functions))
-    {
-      log_error("Failed to open `{}'", arg);
-      return true;
-    }
-  }
-
-  return false;
+  std::vector<std::string> entry_points = {"__ESBMC_main"};
+  if (cmdline.isset("function"))
+    entry_points.push_back(cmdline.getval("function"));
+  goto_reader.set_entry_points(entry_points);
+  return goto_reader.read_goto_binaries(cmdline.args, context, goto_functions);
 }
 
 // This method creates a GOTO program by parsing the input program files.
@@ -1832,8 +1635,10 @@ bool esbmc_parseoptionst::process_goto_program(
   {
     namespacet ns(context);
 
-    bool is_mul =
-      cmdline.isset("multi-property") || cmdline.isset("parallel-solving");
+    bool is_mul = cmdline.isset("multi-property") ||
+                  cmdline.isset("parallel-solving") ||
+                  cmdline.isset("multi-property-incremental") ||
+                  cmdline.isset("claim-result-cache");
     is_coverage = cmdline.isset("assertion-coverage") ||
                   cmdline.isset("assertion-coverage-claims") ||
                   cmdline.isset("condition-coverage") ||
@@ -95,6 +95,9 @@ protected:
   // coverage mode
   bool is_coverage;
 
+  // base case kept between bounds by --incremental-symex
+  std::unique_ptr<bmct> base_case_bmc;
+
 private:
   void close_file(FILE *f)
   {
@@ -128,6 +128,18 @@ const struct group_opt_templ all_cmd_options[] = {
     {"sysroot",
      boost::program_options::value<std::string>()->value_name("<path>"),
      "set the sysroot for the frontend"},
+    {"tu-cache",
+     boost::program_options::value<std::string>()->value_name("<dir>"),
+     "reuse the conversion of unchanged C source files from earlier runs, "
+     "kept in dir"},
+    {"pch-cache",
+     boost::program_options::value<std::string>()->value_name("<dir>"),
+     "precompile the intrinsics and the system headers C source files start "
+     "with, and keep them in dir for later runs"},
+    {"parse-jobs",
+     boost::program_options::value<int>()->value_name("n"),
+     "number of threads parsing the input files with clang, 0 means one per "
+     "hardware thread (default: 1)"},
     {"no-abstracted-cpp-includes",
      NULL,
      "do not include abstract cpp operational models"},
@@ -267,13 +279,25 @@ const struct group_opt_templ all_cmd_options[] = {
     {"slice-assumes", NULL, "remove unused assume statements"},
     {"extended-try-analysis", NULL, ""},
     {"skip-bmc", NULL, "do not perform bounded model checking"},
-    {"cache-asserts", NULL, "cache asserts that were already proven correct"}}},
+    {"cache-asserts", NULL, "cache asserts that were already proven correct"},
+    {"hash-cons",
+     NULL,
+     "share structurally equal expressions of the equation (less memory, "
+     "faster comparisons)"},
+    {"symex-arena",
+     NULL,
+     "allocate the expressions built by each BMC run from a single arena, "
+     "released in bulk once none of them is referenced any more"}}},
   {"Incremental BMC",
    {{"incremental-bmc", NULL, "incremental loop unwinding verification"},
     {"falsification", NULL, "incremental loop unwinding for bug searching"},
     {"termination",
      NULL,
-     "incremental loop unwinding assertion verification"}}},
+     "incremental loop unwinding assertion verification"},
+    {"incremental-symex",
+     NULL,
+     "resume the base case from the previous bound instead of running "
+     "symex from scratch, keeping the shared prefix in the solver"}}},
   {"Solver",
    {{"list-solvers", NULL, "list available solvers and exit"},
     {"boolector", NULL, "use Boolector (default),"},
@@ -300,6 +324,22 @@ const struct group_opt_templ all_cmd_options[] = {
     {"parallel-solving",
      NULL,
      "solve each VCC in parallel (this activates --multi-property)"},
+    {"parallel-solving-jobs",
+     boost::program_options::value<int>()->value_name("n"),
+     "number of worker threads used by --parallel-solving (default: one per "
+     "hardware thread)"},
+    {"portfolio",
+     boost::program_options::value<std::string>()->value_name("<solvers>"),
+     "race the comma-separated solvers (e.g. z3,bitwuzla,yices) on the "
+     "formula and take the first answer; only solvers that can be "
+     "interrupted (Z3, Boolector, Bitwuzla, Yices, MathSAT) are accepted"},
+    {"auto-solver",
+     NULL,
+     "pick the solver and its encoding for each formula from the features "
+     "of the formula"},
+    {"auto-solver-rules",
+     boost::program_options::value<std::string>()->value_name("<file>"),
+     "read the rules of --auto-solver from file"},
     {"smtlib", NULL, "use SMT lib format"},
     {"default-solver",
      boost::program_options::value<std::string>()->value_name("<solver>"),
@@ -327,6 +367,11 @@ const struct group_opt_templ all_cmd_options[] = {
      NULL,
      "encode floating-point as bit-vectors(default for solvers that don't "
      "support the SMT floating-point theory)"},
+    {"fp-refinement",
+     NULL,
+     "encode floating-point as bit-vectors, approximating arithmetic "
+     "operations first and encoding them exactly only where the solver's "
+     "model contradicts them"},
     {"tuple-node-flattener", NULL, "encode tuples using our tuple to node API"},
     {"tuple-sym-flattener",
      NULL,
@@ -354,6 +399,15 @@ const struct group_opt_templ all_cmd_options[] = {
    {{"multi-property",
      NULL,
      "verify satisfiability of all claims of the current bound"},
+    {"multi-property-incremental",
+     NULL,
+     "encode the program once and check each claim on top of it in a "
+     "single solver context (this activates --multi-property)"},
+    {"claim-result-cache",
+     boost::program_options::value<std::string>()->value_name("file"),
+     "skip the solver for claims proven on an identical formula by an "
+     "earlier run, recording new proofs in file (this activates "
+     "--multi-property)"},
     {"no-standard-checks", NULL, "disable default checks"},
     {"no-assertions", NULL, "ignore assertions"},
     {"no-bounds-check", NULL, "do not do array bounds check"},
@@ -428,7 +482,10 @@ const struct group_opt_templ all_cmd_options[] = {
      "conditions"},
     {"k-induction-parallel",
      NULL,
-     "prove by k-induction, running each step on a separate process"},
+     "prove by k-induction, running each step on a separate thread"},
+    {"k-induction-workers",
+     boost::program_options::value<int>()->value_name("n"),
+     "number of threads per step used by --k-induction-parallel (default 1)"},
     {"k-step",
      boost::program_options::value<int>()->default_value(1)->value_name("nr"),
      "set k increment (default is 1)"},
@@ -495,6 +552,14 @@ const struct group_opt_templ all_cmd_options[] = {
     {"interval-analysis-no-contract",
      NULL,
      "disables use of contractors in abstract states (Integers, Reals)"},
+    {"interval-analysis-summaries",
+     NULL,
+     "reuse the results of earlier calls in the same state instead of "
+     "analysing every call again"},
+    {"interval-analysis-jobs",
+     boost::program_options::value<int>()->value_name("n"),
+     "number of threads analysing functions at once, 0 means one per "
+     "hardware thread (default: 1)"},
     {"interval-analysis-assume-asserts",
      NULL,
      "propagates asserts as being assertions (Integers, Reals)"},
@@ -533,6 +598,14 @@ const struct group_opt_templ all_cmd_options[] = {
      NULL,
      "adds intermediate variables to precompute common sub-expressions between "
      "assignments"},
+    {"ai-wto",
+     NULL,
+     "iterate the abstract interpretation of --interval-analysis and --gcse "
+     "in weak topological order, widening only at loop heads"},
+    {"ai-iterations",
+     NULL,
+     "report how many instructions of each function the abstract "
+     "interpretation of --interval-analysis and --gcse visited"},
     {"add-symex-value-sets",
      NULL,
      "enable value-set analysis for pointers and add assumes to the "
@@ -3,12 +3,142 @@
 
 #include "ai.h"
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #include <sstream>
 
 #include <util/std_code.h>
 #include <util/std_expr.h>
+#include <util/thread_pool.h>
+
+namespace
+{
+/* The calls between functions with a body, split into strongly connected
+ * components */
+class call_grapht
+{
+public:
+  explicit call_grapht(const goto_functionst &goto_functions)
+  {
+    forall_goto_functions (f_it, goto_functions)
+    {
+      if (!f_it->second.body_available)
+        continue;
+
+      std::vector<irep_idt> &out = callees[f_it->first];
+      forall_goto_program_instructions (i_it, f_it->second.body)
+      {
+        if (!i_it->is_function_call())
+          continue;
+
+        const expr2tc &f = to_code_function_call2t(i_it->code).function;
+        if (!is_symbol2t(f))
+          continue;
+
+        const irep_idt &callee = to_symbol2t(f).thename;
+        auto it = goto_functions.function_map.find(callee);
+        if (
+          it != goto_functions.function_map.end() &&
+          it->second.body_available)
+          out.push_back(callee);
+      }
+    }
+  }
+
+  std::unordered_map<irep_idt, std::vector<irep_idt>, irep_id_hash> callees;
+
+  /// The components, each after those it calls
+  std::vector<std::vector<irep_idt>> components()
+  {
+    for (const auto &[f, _] : callees)
+      if (!index.count(f))
+        visit(f);
+    return std::move(found);
+  }
+
+private:
+  // Tarjan's algorithm
+  std::unordered_map<irep_idt, unsigned, irep_id_hash> index, lowlink;
+  std::unordered_set<irep_idt, irep_id_hash> on_stack;
+  std::vector<irep_idt> stack;
+  std::vector<std::vector<irep_idt>> found;
+
+  void visit(const irep_idt &f)
+  {
+    unsigned n = index.size();
+    index[f] = lowlink[f] = n;
+    stack.push_back(f);
+    on_stack.insert(f);
+
+    for (const irep_idt &g : callees[f])
+    {
+      if (!index.count(g))
+      {
+        visit(g);
+        lowlink[f] = std::min(lowlink[f], lowlink[g]);
+      }
+      else if (on_stack.count(g))
+        lowlink[f] = std::min(lowlink[f], index[g]);
+    }
+
+    if (lowlink[f] != index[f])
+      return;
+
+    std::vector<irep_idt> component;
+    irep_idt g;
+    do
+    {
+      g = stack.back();
+      stack.pop_back();
+      on_stack.erase(g);
+      component.push_back(g);
+    } while (g != f);
+    found.push_back(std::move(component));
+  }
+};
+
+void collect_symbols(const expr2tc &e, ai_domain_baset::symbolst &symbols)
+{
+  if (is_nil_expr(e))
+    return;
+
+  if (is_symbol2t(e))
+    symbols.insert(to_symbol2t(e).thename);
+
+  e->foreach_operand(
+    [&symbols](const expr2tc &op) { collect_symbols(op, symbols); });
+}
+
+bool has_dereference(const expr2tc &e)
+{
+  if (is_nil_expr(e))
+    return false;
+
+  if (is_dereference2t(e))
+    return true;
+
+  bool found = false;
+  e->foreach_operand(
+    [&found](const expr2tc &op) { found = found || has_dereference(op); });
+  return found;
+}
+
+// Whether `i` may write to variables it doesn't name
+bool is_opaque(const goto_programt::instructiont &i)
+{
+  if (i.is_assign())
+    return has_dereference(to_code_assign2t(i.code).target);
+
+  if (i.is_function_call())
+  {
+    const code_function_call2t &call = to_code_function_call2t(i.code);
+    return !is_symbol2t(call.function) || has_dereference(call.ret);
+  }
+
+  return false;
+}
+} // namespace
 
 void ai_baset::output(const goto_functionst &goto_functions, std::ostream &out)
   const
@@ -35,6 +165,23 @@ void ai_baset::output(const goto_functionst &goto_functions, std::ostream &out)
   }
 }
 
+void ai_baset::output_iterations(std::ostream &out) const
+{
+  std::vector<std::pair<std::string, unsigned>> sorted;
+  for (const auto &[function, count] : iterations)
+    if (count)
+      sorted.emplace_back(function.as_string(), count);
+  std::sort(sorted.begin(), sorted.end());
+
+  unsigned total = 0;
+  for (const auto &[function, count] : sorted)
+  {
+    out << function << ": " << count << "\n";
+    total += count;
+  }
+  out << "total: " << total << "\n";
+}
+
 void ai_baset::entry_state(const goto_functionst &goto_functions)
 {
   // find the 'entry function'
@@ -69,11 +216,34 @@ void ai_baset::initialize(const goto_functionst &goto_functions)
 {
   forall_goto_functions (it, goto_functions)
     initialize(it->second);
+
+  if (use_function_summaries)
+    prepare_summaries(goto_functions);
+
+  // Calls into a recursive function can form a cycle no loop of its body
+  // covers, so merges into its entry widen as well
+  if (iteration_strategy == iteration_strategyt::WTO)
+  {
+    call_grapht graph(goto_functions);
+    for (const std::vector<irep_idt> &component : graph.components())
+      for (const irep_idt &f : component)
+      {
+        const std::vector<irep_idt> &callees = graph.callees.at(f);
+        if (
+          component.size() > 1 ||
+          std::find(callees.begin(), callees.end(), f) != callees.end())
+          widening_points.insert(
+            goto_functions.function_map.at(f).body.instructions.begin());
+      }
+  }
 }
 
 void ai_baset::finalize()
 {
-  // Nothing to do per default
+  // The orderings refer to the program, which may change after the analysis
+  wtos.clear();
+  widening_points.clear();
+  summaries.clear();
 }
 
 goto_programt::const_targett ai_baset::get_next(working_sett &working_set)
@@ -98,8 +268,26 @@ bool ai_baset::fixedpoint(
   if (!goto_program.empty())
     put_in_working_set(working_set, goto_program.instructions.begin());
 
+  return fixedpoint(goto_program, working_set, goto_functions, ns);
+}
+
+bool ai_baset::fixedpoint(
+  const goto_programt &goto_program,
+  working_sett &working_set,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
   bool new_data = false;
 
+  if (iteration_strategy == iteration_strategyt::WTO)
+  {
+    for (const wtot::elementt &e : get_wto(goto_program).elements())
+      if (wto_fixedpoint(e, working_set, goto_program, goto_functions, ns))
+        new_data = true;
+
+    return new_data;
+  }
+
   while (!working_set.empty())
   {
     goto_programt::const_targett l = get_next(working_set);
@@ -112,6 +300,51 @@ bool ai_baset::fixedpoint(
   return new_data;
 }
 
+bool ai_baset::wto_fixedpoint(
+  const wtot::elementt &e,
+  working_sett &working_set,
+  const goto_programt &goto_program,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  if (!e.component)
+  {
+    if (!working_set.erase(e.head->location_number))
+      return false;
+    return visit(e.head, working_set, goto_program, goto_functions, ns);
+  }
+
+  // The body gets a pass even if the head is unchanged, as irreducible
+  // loops can be entered elsewhere. Back edges only lead to heads, so the
+  // component is stable once a pass leaves its head unchanged.
+  bool new_data = false;
+  do
+  {
+    if (
+      working_set.erase(e.head->location_number) &&
+      visit(e.head, working_set, goto_program, goto_functions, ns))
+      new_data = true;
+
+    for (const wtot::elementt &b : e.body)
+      if (wto_fixedpoint(b, working_set, goto_program, goto_functions, ns))
+        new_data = true;
+  } while (working_set.count(e.head->location_number));
+
+  return new_data;
+}
+
+const wtot &ai_baset::get_wto(const goto_programt &goto_program)
+{
+  auto it = wtos.find(&goto_program);
+  if (it == wtos.end())
+  {
+    it = wtos.emplace(&goto_program, wtot(goto_program)).first;
+    const wtot::headst &heads = it->second.get_heads();
+    widening_points.insert(heads.begin(), heads.end());
+  }
+  return it->second;
+}
+
 bool ai_baset::visit(
   goto_programt::const_targett l,
   working_sett &working_set,
@@ -121,6 +354,14 @@ bool ai_baset::visit(
 {
   bool new_data = false;
 
+  // No insertions while parallel_fixedpoint() runs, it adds every function
+  // beforehand
+  auto count = iterations.find(l->function);
+  if (count != iterations.end())
+    count->second++;
+  else
+    iterations.emplace(l->function, 1);
+
   statet &current = get_state(l);
 
   goto_programt::const_targetst successors;
@@ -160,6 +401,9 @@ bool ai_baset::visit(
     {
       new_data = true;
       put_in_working_set(working_set, to_l);
+
+      if (to_l->is_end_function() && !parallel_jobs.empty())
+        parallel_jobs.find(to_l->function)->second.exit_changed = true;
     }
   }
 
@@ -191,6 +435,30 @@ bool ai_baset::do_function_call(
 
   assert(!goto_function.body.instructions.empty());
 
+  auto job = parallel_jobs.find(l_call->function);
+  if (job != parallel_jobs.end())
+    return do_parallel_call(l_call, l_return, f_it, job->second, ns);
+
+  auto summary = summaries.find(f_it->first);
+  if (
+    summary != summaries.end() && !summary->second.recursive &&
+    !summary->second.opaque)
+  {
+    std::unique_ptr<statet> entry(make_temporary_state(get_state(l_call)));
+    entry->transform(
+      l_call, goto_function.body.instructions.begin(), *this, ns);
+
+    if (entry->project(*summary->second.symbols))
+      return do_summarised_call(
+        l_call,
+        l_return,
+        goto_functions,
+        f_it,
+        summary->second,
+        std::move(entry),
+        ns);
+  }
+
   // This is the edge from call site to function head.
 
   {
@@ -237,6 +505,112 @@ bool ai_baset::do_function_call(
   }
 }
 
+void ai_baset::prepare_summaries(const goto_functionst &goto_functions)
+{
+  summaries.clear();
+
+  // Callees come first, so that their summaries are complete by the time
+  // their callers need them
+  call_grapht graph(goto_functions);
+  for (const std::vector<irep_idt> &component : graph.components())
+  {
+    auto symbols = std::make_shared<statet::symbolst>();
+    function_summaryt summary;
+    summary.recursive = component.size() > 1;
+
+    for (const irep_idt &f : component)
+    {
+      symbols->insert(ai_return_symbol(f));
+      forall_goto_program_instructions (
+        i_it, goto_functions.function_map.at(f).body)
+      {
+        collect_symbols(i_it->code, *symbols);
+        collect_symbols(i_it->guard, *symbols);
+        if (is_opaque(*i_it))
+          summary.opaque = true;
+      }
+
+      for (const irep_idt &g : graph.callees.at(f))
+      {
+        if (g == f)
+          summary.recursive = true;
+
+        // Nothing yet for the functions in this component
+        auto it = summaries.find(g);
+        if (it == summaries.end())
+          continue;
+
+        symbols->insert(
+          it->second.symbols->begin(), it->second.symbols->end());
+        if (it->second.opaque)
+          summary.opaque = true;
+      }
+    }
+
+    summary.symbols = symbols;
+    for (const irep_idt &f : component)
+    {
+      function_summaryt &s = summaries[f];
+      s.symbols = summary.symbols;
+      s.recursive = summary.recursive;
+      s.opaque = summary.opaque;
+    }
+  }
+}
+
+bool ai_baset::do_summarised_call(
+  goto_programt::const_targett l_call,
+  goto_programt::const_targett l_return,
+  const goto_functionst &goto_functions,
+  const goto_functionst::function_mapt::const_iterator f_it,
+  function_summaryt &summary,
+  std::unique_ptr<statet> entry,
+  const namespacet &ns)
+{
+  const goto_programt &body = f_it->second.body;
+
+  const size_t key = entry->hash();
+  const statet *exit = nullptr;
+  const auto [first, last] = summary.exits.equal_range(key);
+  for (auto it = first; it != last; ++it)
+  {
+    if (it->second.first->equals(*entry))
+    {
+      exit = it->second.second.get();
+      break;
+    }
+  }
+
+  if (!exit)
+  {
+    // As above, but the function only ever sees what it can access, so that
+    // calls differing elsewhere leave its state alone
+    goto_programt::const_targett l_begin = body.instructions.begin();
+    get_state(l_begin);
+    if (merge(*entry, l_call, l_begin))
+      fixedpoint(body, goto_functions, ns);
+
+    // The state at the end covers every call so far, this one included
+    goto_programt::const_targett l_end = --body.instructions.end();
+    std::unique_ptr<statet> x(make_temporary_state(get_state(l_end)));
+    x->project(*summary.symbols);
+    exit = summary.exits
+             .emplace(key, std::make_pair(std::move(entry), std::move(x)))
+             ->second.second.get();
+  }
+
+  if (exit->is_bottom())
+    return false; // function exit point not reachable
+
+  // The caller's state, updated with what the function may have changed
+  goto_programt::const_targett l_end = --body.instructions.end();
+  std::unique_ptr<statet> tmp_state(make_temporary_state(get_state(l_call)));
+  tmp_state->replace(*exit, *summary.symbols);
+  tmp_state->transform(l_end, l_return, *this, ns);
+
+  return merge(*tmp_state, l_end, l_return);
+}
+
 bool ai_baset::do_function_call_rec(
   goto_programt::const_targett l_call,
   goto_programt::const_targett l_return,
@@ -284,3 +658,261 @@ void ai_baset::sequential_fixedpoint(
   if (f_it != goto_functions.function_map.end())
     fixedpoint(f_it->second.body, goto_functions, ns);
 }
+
+bool ai_baset::do_parallel_call(
+  goto_programt::const_targett l_call,
+  goto_programt::const_targett l_return,
+  const goto_functionst::function_mapt::const_iterator f_it,
+  parallel_jobt &job,
+  const namespacet &ns)
+{
+  const goto_programt &body = f_it->second.body;
+  goto_programt::const_targett l_begin = body.instructions.begin();
+  goto_programt::const_targett l_end = --body.instructions.end();
+
+  std::unique_ptr<statet> entry(make_temporary_state(get_state(l_call)));
+  entry->transform(l_call, l_begin, *this, ns);
+
+  // As with summaries, the callee may only be given what it can access
+  const statet::symbolst *symbols = nullptr;
+  auto summary = summaries.find(f_it->first);
+  if (
+    summary != summaries.end() && !summary->second.recursive &&
+    !summary->second.opaque && entry->project(*summary->second.symbols))
+    symbols = summary->second.symbols.get();
+
+  const statet *exit;
+  const unsigned component = parallel_round.component_of.at(f_it->first);
+  if (component == parallel_round.component_of.at(l_call->function))
+  {
+    exit = parallel_round.exits.at(f_it->first).get();
+    job.entries.push_back({l_call, f_it->first, std::move(entry)});
+  }
+  else
+  {
+    // Nobody writes to the callee's states while it is settled. Its exit
+    // state covers every call to it, this one included
+    std::unique_ptr<statet> begin(make_temporary_state(get_state(l_begin)));
+    if (
+      parallel_round.unsettled[component] ||
+      merge(*begin, *entry, l_call, l_begin))
+    {
+      // Done again once the callee is
+      job.entries.push_back({l_call, f_it->first, std::move(entry)});
+      return false;
+    }
+    exit = &get_state(l_end);
+  }
+
+  if (exit->is_bottom())
+    return false; // function exit point not reachable
+
+  std::unique_ptr<statet> tmp_state(
+    make_temporary_state(symbols ? get_state(l_call) : *exit));
+  if (symbols)
+    tmp_state->replace(*exit, *symbols);
+  tmp_state->transform(l_end, l_return, *this, ns);
+
+  return merge(*tmp_state, l_end, l_return);
+}
+
+void ai_baset::parallel_fixedpoint(
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  goto_functionst::function_mapt::const_iterator main =
+    goto_functions.function_map.find(goto_functions.main_id());
+  if (
+    main == goto_functions.function_map.end() ||
+    !main->second.body_available || main->second.body.empty())
+    return;
+
+  call_grapht graph(goto_functions);
+  const std::vector<std::vector<irep_idt>> components = graph.components();
+  std::unordered_map<irep_idt, unsigned, irep_id_hash> &component_of =
+    parallel_round.component_of;
+  for (unsigned c = 0; c < components.size(); c++)
+    for (const irep_idt &f : components[c])
+      component_of[f] = c;
+
+  // The calls between components both ways, and the calls within them
+  std::vector<std::vector<unsigned>> calls(components.size());
+  std::vector<std::vector<unsigned>> called_by(components.size());
+  std::unordered_map<
+    irep_idt,
+    std::vector<std::pair<irep_idt, goto_programt::const_targett>>,
+    irep_id_hash>
+    inner_calls;
+  for (const auto &[f, callees] : graph.callees)
+  {
+    const unsigned c = component_of.at(f);
+    for (const irep_idt &g : callees)
+    {
+      const unsigned d = component_of.at(g);
+      if (c == d)
+        continue;
+      calls[c].push_back(d);
+      called_by[d].push_back(c);
+    }
+
+    forall_goto_program_instructions (
+      i_it, goto_functions.function_map.at(f).body)
+    {
+      if (!i_it->is_function_call())
+        continue;
+
+      const expr2tc &callee = to_code_function_call2t(i_it->code).function;
+      if (!is_symbol2t(callee))
+        continue;
+
+      const irep_idt &g = to_symbol2t(callee).thename;
+      auto it = component_of.find(g);
+      if (it != component_of.end() && it->second == c)
+        inner_calls[g].emplace_back(f, i_it);
+    }
+  }
+
+  // The components reachable from `from` along `edges`
+  auto reach = [&components](
+                 std::vector<unsigned> from,
+                 const std::vector<std::vector<unsigned>> &edges) {
+    std::vector<bool> reached(components.size(), false);
+    while (!from.empty())
+    {
+      unsigned c = from.back();
+      from.pop_back();
+      if (reached[c])
+        continue;
+      reached[c] = true;
+      from.insert(from.end(), edges[c].begin(), edges[c].end());
+    }
+    return reached;
+  };
+
+  // Nothing shared may be inserted into while the threads run
+  forall_goto_functions (f_it, goto_functions)
+  {
+    iterations.emplace(f_it->first, 0);
+    if (
+      f_it->second.body_available &&
+      iteration_strategy == iteration_strategyt::WTO)
+      get_wto(f_it->second.body);
+  }
+
+  std::unordered_map<irep_idt, working_sett, irep_id_hash> scheduled;
+  put_in_working_set(
+    scheduled[main->first], main->second.body.instructions.begin());
+
+  // The calls to do again once the callee's component is settled
+  std::unordered_map<
+    irep_idt,
+    std::vector<std::pair<irep_idt, goto_programt::const_targett>>,
+    irep_id_hash>
+    waiting;
+
+  // A component has work to do while one of its functions is scheduled or
+  // has calls waiting, and so do its callers
+  auto unsettled = [&]() {
+    std::vector<unsigned> busy;
+    for (const auto &[f, _] : scheduled)
+      busy.push_back(component_of.at(f));
+    for (const auto &[g, sites] : waiting)
+      for (const auto &[f, _] : sites)
+        busy.push_back(component_of.at(f));
+    return reach(busy, called_by);
+  };
+
+  bounded_worker_poolt pool(fixedpoint_jobs);
+  while (!scheduled.empty())
+  {
+    parallel_round.unsettled = unsettled();
+
+    // The components called, maybe indirectly, by a scheduled function in
+    // another component have to wait for it. As the components form a DAG,
+    // some scheduled function is always left to run.
+    std::vector<unsigned> callees;
+    for (const auto &[f, _] : scheduled)
+    {
+      const std::vector<unsigned> &c = calls[component_of.at(f)];
+      callees.insert(callees.end(), c.begin(), c.end());
+    }
+    const std::vector<bool> blocked = reach(callees, calls);
+
+    std::vector<irep_idt> runnable;
+    for (const auto &[f, _] : scheduled)
+    {
+      if (blocked[component_of.at(f)])
+        continue;
+
+      runnable.push_back(f);
+      parallel_jobs[f];
+      for (const irep_idt &g : graph.callees.at(f))
+      {
+        if (
+          component_of.at(g) != component_of.at(f) ||
+          parallel_round.exits.count(g))
+          continue;
+
+        const goto_programt &body = goto_functions.function_map.at(g).body;
+        parallel_round.exits.emplace(
+          g, make_temporary_state(get_state(--body.instructions.end())));
+      }
+    }
+
+    pool.run(runnable, [&](const irep_idt &f) {
+      fixedpoint(
+        goto_functions.function_map.at(f).body,
+        scheduled.at(f),
+        goto_functions,
+        ns);
+    });
+
+    for (const irep_idt &f : runnable)
+      scheduled.erase(f);
+
+    // Hand the entry states over to the callees
+    for (const irep_idt &f : runnable)
+    {
+      for (parallel_jobt::entryt &entry : parallel_jobs.at(f).entries)
+      {
+        goto_programt::const_targett l_begin =
+          goto_functions.function_map.at(entry.function)
+            .body.instructions.begin();
+        if (merge(*entry.state, entry.l_call, l_begin))
+          put_in_working_set(scheduled[entry.function], l_begin);
+
+        if (component_of.at(entry.function) != component_of.at(f))
+          waiting[entry.function].emplace_back(f, entry.l_call);
+      }
+    }
+
+    for (const irep_idt &f : runnable)
+    {
+      if (!parallel_jobs.at(f).exit_changed)
+        continue;
+
+      for (const auto &[caller, l_call] : inner_calls[f])
+        put_in_working_set(scheduled[caller], l_call);
+    }
+
+    parallel_jobs.clear();
+    parallel_round.exits.clear();
+
+    // Release the calls to the components that are done now
+    const std::vector<bool> still_unsettled = unsettled();
+    for (auto it = waiting.begin(); it != waiting.end();)
+    {
+      if (still_unsettled[component_of.at(it->first)])
+      {
+        ++it;
+        continue;
+      }
+
+      for (const auto &[caller, l_call] : it->second)
+        put_in_working_set(scheduled[caller], l_call);
+      it = waiting.erase(it);
+    }
+  }
+
+  parallel_round = parallel_roundt();
+}
@@ -7,7 +7,9 @@
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <goto-programs/abstract-interpretation/ai_domain.h>
+#include <goto-programs/abstract-interpretation/wto.h>
 #include <goto-programs/goto_functions.h>
 #include <util/xml.h>
 #include <util/expr.h>
@@ -30,6 +32,28 @@ public:
 
   ai_baset() = default;
 
+  /// Order in which the fixedpoint visits the instructions of a function
+  enum class iteration_strategyt
+  {
+    /// Whichever instruction with a changed state get_next() picks
+    WORKLIST,
+    /// Weak topological order, stabilising inner loops first and only
+    /// widening at loop heads and at the entries of recursive functions,
+    /// see wtot
+    WTO
+  };
+
+  iteration_strategyt iteration_strategy = iteration_strategyt::WORKLIST;
+
+  /// Whether calls reuse the exit states computed for equal entry states,
+  /// restricted to the variables the callee can access; see
+  /// do_function_call. Needs a domain implementing project().
+  bool use_function_summaries = false;
+
+  /// Threads the analysis of a whole program runs functions on, 0 for one
+  /// per hardware thread; see parallel_fixedpoint()
+  unsigned fixedpoint_jobs = 1;
+
   /**
    * @brief Run analysis over Program
    *
@@ -75,11 +99,15 @@ public:
   /// Resets the domain
   virtual void clear()
   {
+    iterations.clear();
   }
 
   virtual void
   output(const goto_functionst &goto_functions, std::ostream &out) const;
 
+  /// Prints how many instructions of each function the analysis visited
+  void output_iterations(std::ostream &out) const;
+
 protected:
   // overload to add a factory
   virtual void initialize(const goto_programt &);
@@ -114,6 +142,31 @@ protected:
     const goto_functionst &goto_functions,
     const namespacet &ns);
 
+  /// As above, starting from the instructions in `working_set`
+  bool fixedpoint(
+    const goto_programt &goto_program,
+    working_sett &working_set,
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+  /* Iterates `e` until its head is stable, visiting only the instructions
+   * in `working_set`, i.e. those whose state changed since their last visit
+   */
+  bool wto_fixedpoint(
+    const wtot::elementt &e,
+    working_sett &working_set,
+    const goto_programt &goto_program,
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+  const wtot &get_wto(const goto_programt &goto_program);
+
+  /// Whether merges into `l` should widen, see iteration_strategyt::WTO
+  bool is_widening_point(goto_programt::const_targett l) const
+  {
+    return widening_points.count(l) != 0;
+  }
+
   virtual void
   fixedpoint(const goto_functionst &goto_functions, const namespacet &ns) = 0;
 
@@ -121,6 +174,67 @@ protected:
     const goto_functionst &goto_functions,
     const namespacet &ns);
 
+  /* Analyses the functions of the program in rounds on a thread pool. A
+   * round runs every function with pending work, unless it is called, maybe
+   * indirectly, by another such function outside its strongly connected
+   * component of the call graph. Calls don't descend into the callee: its
+   * entry state is merged between rounds, and its exit state is only read
+   * once its component and all those it calls are done with an entry state
+   * covering the call's, so that each function's states are only ever
+   * written by the thread analysing it. Calls within a component read the
+   * exit state as of the start of the round and are done again when it
+   * changes.
+   *
+   * Every call thus reads the callee's exit state for the join of all its
+   * entry states, not the exit summarised for its own entry as the
+   * sequential analysis does (see use_function_summaries), which may be
+   * less precise where a function is called in different states. */
+  void parallel_fixedpoint(
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+  /* What a function analysed by parallel_fixedpoint() leaves for the others
+   * to see in the next round */
+  struct parallel_jobt
+  {
+    struct entryt
+    {
+      goto_programt::const_targett l_call;
+      irep_idt function;
+      std::unique_ptr<statet> state;
+    };
+
+    /// Entry states of the functions it calls
+    std::vector<entryt> entries;
+    /// Whether the state at its end changed
+    bool exit_changed = false;
+  };
+
+  /// The functions in the current round of parallel_fixedpoint()
+  std::unordered_map<irep_idt, parallel_jobt, irep_id_hash> parallel_jobs;
+
+  /* What the threads of parallel_fixedpoint() read during a round */
+  struct parallel_roundt
+  {
+    /// Strongly connected component of the call graph, by function
+    std::unordered_map<irep_idt, unsigned, irep_id_hash> component_of;
+    /// Whether a component or one it calls still has work to do
+    std::vector<bool> unsettled;
+    /// Exit states of the functions called from their own component
+    std::unordered_map<irep_idt, std::unique_ptr<statet>, irep_id_hash>
+      exits;
+  };
+  parallel_roundt parallel_round;
+
+  /* The call from `l_call` to `f_it` during a round of
+   * parallel_fixedpoint(), on behalf of `job` */
+  bool do_parallel_call(
+    goto_programt::const_targett l_call,
+    goto_programt::const_targett l_return,
+    const goto_functionst::function_mapt::const_iterator f_it,
+    parallel_jobt &job,
+    const namespacet &ns);
+
   // Visit performs one step of abstract interpretation from location l
   // Depending on the instruction type it may compute a number of "edges"
   // or applications of the abstract transformer
@@ -147,12 +261,54 @@ protected:
     const goto_functionst::function_mapt::const_iterator f_it,
     const namespacet &ns);
 
+  struct function_summaryt
+  {
+    /// Variables the function and the functions it calls can access
+    std::shared_ptr<const statet::symbolst> symbols;
+    /// Whether the function calls itself, directly or through others
+    bool recursive = false;
+    /// Whether the function, or one it calls, writes through a pointer or
+    /// calls a function pointer, so that its effect isn't limited to
+    /// `symbols`
+    bool opaque = false;
+    /// Projected exit states computed so far, by projected entry state,
+    /// keyed by the entry state's hash()
+    std::unordered_multimap<
+      size_t,
+      std::pair<std::unique_ptr<statet>, std::unique_ptr<statet>>>
+      exits;
+  };
+
+  /// Summaries of the functions with a body, see use_function_summaries
+  std::unordered_map<irep_idt, function_summaryt, irep_id_hash> summaries;
+
+  /* Computes what the summaries need to know about each function, bottom-up
+   * over the call graph */
+  void prepare_summaries(const goto_functionst &goto_functions);
+
+  /* The call from `l_call` to the start of the summarised function `f_it`
+   * with `entry`, the projected state it is called in */
+  bool do_summarised_call(
+    goto_programt::const_targett l_call,
+    goto_programt::const_targett l_return,
+    const goto_functionst &goto_functions,
+    const goto_functionst::function_mapt::const_iterator f_it,
+    function_summaryt &summary,
+    std::unique_ptr<statet> entry,
+    const namespacet &ns);
+
   // abstract methods
 
   virtual bool merge(
     const statet &src,
     goto_programt::const_targett from,
     goto_programt::const_targett to) = 0;
+  /// As above, into `dest` rather than the state at `to`
+  virtual bool merge(
+    statet &dest,
+    const statet &src,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to) = 0;
   // for concurrent fixedpoint
   virtual bool merge_shared(
     const statet &src,
@@ -162,6 +318,14 @@ protected:
   virtual statet &get_state(goto_programt::const_targett l) = 0;
   virtual const statet &find_state(goto_programt::const_targett l) const = 0;
   virtual std::unique_ptr<statet> make_temporary_state(const statet &s) = 0;
+
+  /// Number of instructions visited, by function
+  std::unordered_map<irep_idt, unsigned, irep_id_hash> iterations;
+
+private:
+  // Orderings of the functions analysed so far, see finalize()
+  std::unordered_map<const goto_programt *, wtot> wtos;
+  wtot::headst widening_points;
 };
 
 // domainT is expected to be derived from ai_domain_baseT
@@ -229,6 +393,12 @@ protected:
   // this one creates states, if need be
   virtual statet &get_state(goto_programt::const_targett l) override
   {
+    // initialize() creates the states of every instruction, so that the
+    // threads of parallel_fixedpoint() only ever look them up
+    typename state_mapt::iterator it = state_map.find(l);
+    if (it != state_map.end())
+      return it->second;
+
     return state_map[l]; // calls default constructor
   }
 
@@ -247,7 +417,19 @@ protected:
     goto_programt::const_targett from,
     goto_programt::const_targett to) override
   {
-    statet &dest = get_state(to);
+    return merge(get_state(to), src, from, to);
+  }
+
+  bool merge(
+    statet &dest,
+    const statet &src,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to) override
+  {
+    if (iteration_strategy == iteration_strategyt::WTO)
+      return static_cast<domainT &>(dest).merge(
+        static_cast<const domainT &>(src), from, to, is_widening_point(to));
+
     return static_cast<domainT &>(dest).merge(
       static_cast<const domainT &>(src), from, to);
   }
@@ -260,7 +442,10 @@ protected:
   void fixedpoint(const goto_functionst &goto_functions, const namespacet &ns)
     override
   {
-    sequential_fixedpoint(goto_functions, ns);
+    if (fixedpoint_jobs == 1)
+      sequential_fixedpoint(goto_functions, ns);
+    else
+      parallel_fixedpoint(goto_functions, ns);
   }
 
 private:
@@ -50,3 +50,8 @@ bool ai_domain_baset::ai_simplify_lhs(expr2tc &condition, const namespacet &ns)
 
   return true;
 }
+
+irep_idt ai_return_symbol(const irep_idt &function)
+{
+  return "c:" + function.as_string() + ":ret";
+}
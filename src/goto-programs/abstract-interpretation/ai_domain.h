@@ -6,6 +6,7 @@
 
 #include <goto-programs/goto_program.h>
 #include <irep2/irep2_utils.h>
+#include <unordered_set>
 
 // forward reference the abstract interpreter interface
 class ai_baset;
@@ -73,6 +74,14 @@ public:
   ///
   /// PRECONDITION(from.is_dereferenceable(), "Must not be _::end()")
   /// PRECONDITION(to.is_dereferenceable(), "Must not be _::end()")
+  ///
+  /// and
+  ///
+  ///   bool merge(const T &b, const_targett from, const_targett to,
+  ///              bool widen);
+  ///
+  /// which the weak topological iteration uses instead. It should only
+  /// widen if "widen" is set, which it is at the heads of loops.
 
   /// This method allows an expression to be simplified / evaluated using the
   /// current state.  It is used to evaluate assertions and in program
@@ -84,6 +93,36 @@ public:
   /// Simplifies the expression but keeps it as an l-value
   virtual bool ai_simplify_lhs(expr2tc &condition, const namespacet &ns) const;
 
+  typedef std::unordered_set<irep_idt, irep_id_hash> symbolst;
+
+  /// Function summaries (see ai_baset::do_function_call) split states into
+  /// the variables a function can access and the rest. This forgets what
+  /// the state knows about any variable not in `symbols`. Domains that can't
+  /// return false, which leaves calls to be analysed without summaries.
+  virtual bool project(const symbolst &)
+  {
+    return false;
+  }
+
+  /// Sets the variables in `symbols` to their values in `b`, a projected
+  /// state of the same domain
+  virtual void replace(const ai_domain_baset &, const symbolst &)
+  {
+  }
+
+  /// Whether `b`, a state of the same domain, represents the same states
+  virtual bool equals(const ai_domain_baset &) const
+  {
+    return false;
+  }
+
+  /// A hash of the states represented, equal for states that equals()
+  /// says are the same. Function summaries find their entry states by it.
+  virtual size_t hash() const
+  {
+    return 0;
+  }
+
   /// Gives a Boolean condition that is true for all values represented by the
   /// domain.  This allows domains to be converted into program invariants.
   virtual expr2tc to_predicate(void) const
@@ -94,4 +133,7 @@ public:
   }
 };
 
+/// The variable domains keep the value returned by `function` in
+irep_idt ai_return_symbol(const irep_idt &function);
+
 #endif
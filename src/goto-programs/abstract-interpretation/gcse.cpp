@@ -7,6 +7,7 @@
 #include <goto-programs/abstract-interpretation/gcse.h>
 #include <ostream>
 #include <sstream>
+#include <util/config.h>
 #include <util/prefix.h>
 #include <fmt/format.h>
 // TODO: Do an points-to abstract interpreter
@@ -257,8 +258,17 @@ bool goto_cse::runOnProgram(goto_functionst &F)
   // Initialization for the abstract analysis.
   const namespacet ns(context);
   log_status("{}", "[CSE] Computing Available Expressions for program");
+  if (config.options.get_bool_option("ai-wto"))
+    available_expressions.iteration_strategy =
+      ai_baset::iteration_strategyt::WTO;
   available_expressions(F, ns);
   log_status("{}", "[CSE] Finished computing AE for program");
+  if (config.options.get_bool_option("ai-iterations"))
+  {
+    std::ostringstream oss;
+    available_expressions.output_iterations(oss);
+    log_status("[CSE] Instructions visited by function:\n{}", oss.str());
+  }
   // Let's release the reference. TODO: create the "VSA aware" abstract interpreter
   cse_domaint::vsa = nullptr;
   return false;
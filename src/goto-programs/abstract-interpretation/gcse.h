@@ -88,6 +88,16 @@ public:
     const cse_domaint &b,
     goto_programt::const_targett,
     goto_programt::const_targett);
+
+  /// Intersections only shrink the sets, so there is nothing to widen
+  bool merge(
+    const cse_domaint &b,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to,
+    bool)
+  {
+    return merge(b, from, to);
+  }
   /// All expressions available
   std::unordered_set<expr2tc, irep2_hash> available_expressions;
 
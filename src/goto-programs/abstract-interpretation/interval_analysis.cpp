@@ -274,8 +274,30 @@ void interval_analysis(
   // TODO: add options for instrumentation mode
   ait<interval_domaint> interval_analysis;
   interval_domaint::set_options(options);
+  if (options.get_bool_option("ai-wto"))
+    interval_analysis.iteration_strategy = ai_baset::iteration_strategyt::WTO;
+  interval_analysis.use_function_summaries =
+    options.get_bool_option("interval-analysis-summaries");
+  const std::string jobs = options.get_option("interval-analysis-jobs");
+  if (!jobs.empty())
+  {
+    if (stoi(jobs) < 0)
+    {
+      log_error("the value of interval-analysis-jobs should be positive!");
+      abort();
+    }
+    interval_analysis.fixedpoint_jobs = stoi(jobs);
+  }
   interval_analysis(goto_functions, ns);
 
+  if (options.get_bool_option("ai-iterations"))
+  {
+    std::ostringstream oss;
+    interval_analysis.output_iterations(oss);
+    log_status(
+      "Interval Analysis instructions visited by function:\n{}", oss.str());
+  }
+
   if (options.get_bool_option("interval-analysis-dump"))
   {
     std::ostringstream oss;
@@ -3,6 +3,8 @@
 // TODO: Ternary operators, lessthan into lessthanequal for integers
 #include <goto-programs/abstract-interpretation/interval_domain.h>
 #include <goto-programs/abstract-interpretation/bitwise_bounds.h>
+#include <boost/functional/hash.hpp>
+#include <type_traits>
 #include <util/arith_tools.h>
 #include <util/c_typecast.h>
 #include <util/std_expr.h>
@@ -974,8 +976,8 @@ void interval_domaint::transform(
      * the return variable (which would be too tricky anyway). We can deal
      * with this by constructing a tmp symbol in which we can apply assumptions
      * later */
-    expr2tc return_var = symbol2tc(
-      function.ret_type, fmt::format("c:{}:ret", instruction.function));
+    expr2tc return_var =
+      symbol2tc(function.ret_type, ai_return_symbol(instruction.function));
 
     assign(
       code_assign2tc(return_var, to_code_return2t(instruction.code).operand));
@@ -1057,8 +1059,7 @@ void interval_domaint::transform(
     if (!is_nil_expr(code_function_call.ret))
     {
       expr2tc return_var = symbol2tc(
-        code_function_call.ret->type,
-        fmt::format("c:{}:ret", instruction.function));
+        code_function_call.ret->type, ai_return_symbol(instruction.function));
       assign(code_assign2tc(code_function_call.ret, return_var));
     }
   }
@@ -1189,6 +1190,13 @@ bool interval_domaint::join(
 bool interval_domaint::join(
   const interval_domaint &b,
   const goto_programt::const_targett &to)
+{
+  const bool is_if_goto = to->is_goto() && !is_true(to->guard);
+  const bool is_guard = to->is_assume() || to->is_assert() || is_if_goto;
+  return join(b, is_guard);
+}
+
+bool interval_domaint::join(const interval_domaint &b, bool extrapolate)
 {
   if (b.is_bottom() || is_top())
     return false;
@@ -1210,11 +1218,114 @@ bool interval_domaint::join(
   // to expend much time on this.
   copy_if_needed();
 
-  const bool is_if_goto = to->is_goto() && !is_true(to->guard);
-  const bool is_guard = to->is_assume() || to->is_assert() || is_if_goto;
-
   // Prevent short-circuit
-  bool result = join(*intervals, *b.intervals, is_guard);
+  bool result = join(*intervals, *b.intervals, extrapolate);
+  return result;
+}
+
+bool interval_domaint::project(const symbolst &symbols)
+{
+  if (is_bottom())
+    return true;
+
+  copy_if_needed();
+  for (auto it = intervals->begin(); it != intervals->end();)
+  {
+    if (symbols.count(it->first))
+      ++it;
+    else
+      it = intervals->erase(it);
+  }
+  return true;
+}
+
+void interval_domaint::replace(
+  const ai_domain_baset &b,
+  const symbolst &symbols)
+{
+  const interval_domaint &d = static_cast<const interval_domaint &>(b);
+  if (is_bottom())
+    return;
+
+  if (d.is_bottom())
+  {
+    make_bottom();
+    return;
+  }
+
+  // Intervals are never changed in place, so the maps can share them
+  copy_if_needed();
+  for (const irep_idt &symbol : symbols)
+  {
+    const auto it = d.intervals->find(symbol);
+    if (it == d.intervals->end())
+      intervals->erase(symbol);
+    else
+      (*intervals)[symbol] = it->second;
+  }
+}
+
+bool interval_domaint::equals(const ai_domain_baset &b) const
+{
+  const interval_domaint &d = static_cast<const interval_domaint &>(b);
+  if (is_bottom() || d.is_bottom())
+    return is_bottom() == d.is_bottom();
+
+  if (intervals == d.intervals)
+    return true;
+
+  if (intervals->size() != d.intervals->size())
+    return false;
+
+  for (const auto &[symbol, value] : *intervals)
+  {
+    const auto it = d.intervals->find(symbol);
+    if (it == d.intervals->end() || it->second.index() != value.index())
+      return false;
+
+    const bool same = std::visit(
+      [&it](const auto &a) {
+        const auto &b = std::get<std::decay_t<decltype(a)>>(it->second);
+        return a == b || *a == *b;
+      },
+      value);
+    if (!same)
+      return false;
+  }
+
+  return true;
+}
+
+size_t interval_domaint::hash() const
+{
+  if (is_bottom())
+    return 0;
+
+  // The order of the map is unspecified, so the entries are summed up. Only
+  // the integer bounds that fit are hashed, which is enough to tell most
+  // states apart.
+  size_t result = 1;
+  for (const auto &[symbol, value] : *intervals)
+  {
+    size_t entry = irep_id_hash()(symbol);
+    boost::hash_combine(entry, value.index());
+    std::visit(
+      [&entry](const auto &i) {
+        boost::hash_combine(entry, i->lower.has_value());
+        boost::hash_combine(entry, i->upper.has_value());
+        if constexpr (std::is_base_of_v<
+                        integer_intervalt,
+                        typename std::decay_t<decltype(i)>::element_type>)
+        {
+          if (i->lower && i->lower->is_int64())
+            boost::hash_combine(entry, i->lower->to_int64());
+          if (i->upper && i->upper->is_int64())
+            boost::hash_combine(entry, i->upper->to_int64());
+        }
+      },
+      value);
+    result += entry;
+  }
   return result;
 }
 
@@ -103,6 +103,9 @@ protected:
   */
   bool join(const interval_domaint &b, const goto_programt::const_targett &to);
 
+  /// Like join above, extrapolating the changed bounds only if `extrapolate`
+  bool join(const interval_domaint &b, bool extrapolate);
+
 public:
   bool merge(
     const interval_domaint &b,
@@ -114,6 +117,22 @@ public:
     return result;
   }
 
+  bool merge(
+    const interval_domaint &b,
+    goto_programt::const_targett,
+    goto_programt::const_targett,
+    bool widen)
+  {
+    const bool result = join(b, widen);
+    copied = false;
+    return result;
+  }
+
+  bool project(const symbolst &symbols) override;
+  void replace(const ai_domain_baset &b, const symbolst &symbols) override;
+  bool equals(const ai_domain_baset &b) const override;
+  size_t hash() const override;
+
   void clear_state()
   {
     intervals = get_empty();
@@ -0,0 +1,227 @@
+/// \file
+/// Weak Topological Ordering
+
+#include <goto-programs/abstract-interpretation/wto.h>
+
+#include <algorithm>
+#include <numeric>
+#include <ostream>
+#include <unordered_map>
+
+namespace
+{
+/* Builds the ordering over the instructions reachable from the entry, which
+ * are numbered as they are reached */
+class wto_buildert
+{
+public:
+  explicit wto_buildert(const goto_programt &goto_program)
+  {
+    std::vector<unsigned> stack{number(goto_program.instructions.begin())};
+    goto_programt::const_targetst next;
+    while (!stack.empty())
+    {
+      unsigned v = stack.back();
+      stack.pop_back();
+
+      goto_program.get_successors(targets[v], next);
+      for (const goto_programt::const_targett &l : next)
+      {
+        if (l == goto_program.instructions.end())
+          continue;
+
+        size_t known = targets.size();
+        unsigned w = number(l);
+        successors[v].push_back(w);
+        if (w == known)
+          stack.push_back(w);
+      }
+    }
+
+    scope.assign(targets.size(), 0);
+    index.assign(targets.size(), unvisited);
+    lowlink.assign(targets.size(), 0);
+    on_stack.assign(targets.size(), false);
+  }
+
+  void build(std::vector<wtot::elementt> &top, wtot::headst &heads)
+  {
+    std::vector<unsigned> all(targets.size());
+    std::iota(all.begin(), all.end(), 0);
+    decompose({0}, all, top, heads);
+  }
+
+private:
+  static constexpr unsigned unvisited = ~0u;
+
+  std::unordered_map<
+    goto_programt::const_targett,
+    unsigned,
+    const_target_hash,
+    pointee_address_equalt>
+    numbers;
+  std::vector<goto_programt::const_targett> targets;
+  std::vector<std::vector<unsigned>> successors;
+
+  // State of Tarjan's algorithm, by instruction number
+  std::vector<unsigned> scope, index, lowlink;
+  std::vector<bool> on_stack;
+  unsigned last_scope = 0;
+
+  unsigned number(goto_programt::const_targett l)
+  {
+    auto [it, inserted] = numbers.emplace(l, targets.size());
+    if (inserted)
+    {
+      targets.push_back(l);
+      successors.emplace_back();
+    }
+    return it->second;
+  }
+
+  /* Appends the ordering of `vertices` to `out`; all of them must be
+   * reachable from `entries` without leaving `vertices` */
+  void decompose(
+    const std::vector<unsigned> &entries,
+    const std::vector<unsigned> &vertices,
+    std::vector<wtot::elementt> &out,
+    wtot::headst &heads)
+  {
+    const unsigned current = ++last_scope;
+    for (unsigned v : vertices)
+    {
+      scope[v] = current;
+      index[v] = unvisited;
+    }
+
+    // Tarjan's algorithm without recursion, as functions can be long. The
+    // root of each strongly connected part is the first vertex reached in it
+    // and is popped last.
+    struct framet
+    {
+      unsigned vertex;
+      size_t next;
+    };
+    std::vector<framet> dfs;
+    std::vector<unsigned> stack;
+    std::vector<std::vector<unsigned>> parts;
+    unsigned counter = 0;
+
+    auto enter = [&](unsigned v) {
+      index[v] = lowlink[v] = counter++;
+      stack.push_back(v);
+      on_stack[v] = true;
+      dfs.push_back({v, 0});
+    };
+
+    for (unsigned e : entries)
+    {
+      if (scope[e] != current || index[e] != unvisited)
+        continue;
+
+      enter(e);
+      while (!dfs.empty())
+      {
+        unsigned v = dfs.back().vertex;
+        if (dfs.back().next < successors[v].size())
+        {
+          unsigned w = successors[v][dfs.back().next++];
+          // Edges leaving `vertices`, e.g. back to the head of the component
+          // being split, don't count
+          if (scope[w] != current)
+            continue;
+
+          if (index[w] == unvisited)
+            enter(w);
+          else if (on_stack[w])
+            lowlink[v] = std::min(lowlink[v], index[w]);
+          continue;
+        }
+
+        dfs.pop_back();
+        if (!dfs.empty())
+        {
+          unsigned u = dfs.back().vertex;
+          lowlink[u] = std::min(lowlink[u], lowlink[v]);
+        }
+
+        if (lowlink[v] != index[v])
+          continue;
+
+        std::vector<unsigned> part;
+        unsigned w;
+        do
+        {
+          w = stack.back();
+          stack.pop_back();
+          on_stack[w] = false;
+          part.push_back(w);
+        } while (w != v);
+        parts.push_back(std::move(part));
+      }
+    }
+
+    // Tarjan's algorithm finds the parts in reverse topological order
+    for (auto it = parts.rbegin(); it != parts.rend(); ++it)
+    {
+      std::vector<unsigned> &part = *it;
+      const unsigned head = part.back();
+      part.pop_back();
+
+      const std::vector<unsigned> &next = successors[head];
+      wtot::elementt e;
+      e.head = targets[head];
+      e.component = !part.empty() ||
+                    std::find(next.begin(), next.end(), head) != next.end();
+      if (e.component)
+      {
+        heads.insert(e.head);
+        // Without the head, the rest of the part may fall apart into
+        // further components
+        decompose(next, part, e.body, heads);
+      }
+      out.push_back(std::move(e));
+    }
+  }
+};
+
+void output_elements(
+  const std::vector<wtot::elementt> &elements,
+  std::ostream &out)
+{
+  for (const wtot::elementt &e : elements)
+  {
+    if (&e != &elements.front())
+      out << " ";
+
+    if (!e.component)
+    {
+      out << e.head->location_number;
+      continue;
+    }
+
+    out << "(" << e.head->location_number;
+    if (!e.body.empty())
+    {
+      out << " ";
+      output_elements(e.body, out);
+    }
+    out << ")";
+  }
+}
+} // namespace
+
+wtot::wtot(const goto_programt &goto_program)
+{
+  if (goto_program.empty())
+    return;
+
+  wto_buildert builder(goto_program);
+  builder.build(top, heads);
+}
+
+void wtot::output(std::ostream &out) const
+{
+  output_elements(top, out);
+  out << "\n";
+}
@@ -0,0 +1,70 @@
+/// \file
+/// Weak Topological Ordering
+
+#ifndef CPROVER_ANALYSES_WTO_H
+#define CPROVER_ANALYSES_WTO_H
+
+#include <goto-programs/goto_program.h>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Weak topological ordering of the instructions of a goto program,
+ * see Bourdoncle, "Efficient chaotic iteration strategies with widenings"
+ * (1993).
+ *
+ * The ordering is a sequence of elements, each of which is an instruction
+ * or a component: a head instruction followed by the ordering of the rest of
+ * a strongly connected part of the control flow graph, e.g.
+ *
+ *   1 2 (3 4 (5 6) 7) 8
+ *
+ * for a loop 3..7 with a nested loop 5..6. Every edge either goes forward in
+ * the sequence or back to the head of a component containing its source, so
+ * iterating each component until its head is stable reaches the fixedpoint,
+ * and the heads are the only places that need widening.
+ *
+ * Components are built by recursively splitting the strongly connected
+ * parts of the graph at their first instruction reached from the entry,
+ * which gives the same ordering as Bourdoncle's algorithm but only recurses
+ * as deep as loops are nested. Instructions unreachable from the entry are
+ * left out.
+ */
+class wtot
+{
+public:
+  struct elementt
+  {
+    goto_programt::const_targett head;
+    /// Whether this is a component, to be iterated until `head` is stable
+    bool component = false;
+    std::vector<elementt> body;
+  };
+
+  typedef std::unordered_set<
+    goto_programt::const_targett,
+    const_target_hash,
+    pointee_address_equalt>
+    headst;
+
+  explicit wtot(const goto_programt &goto_program);
+
+  const std::vector<elementt> &elements() const
+  {
+    return top;
+  }
+
+  /// The heads of all components, i.e. the widening points
+  const headst &get_heads() const
+  {
+    return heads;
+  }
+
+  void output(std::ostream &out) const;
+
+protected:
+  std::vector<elementt> top;
+  headst heads;
+};
+
+#endif // CPROVER_ANALYSES_WTO_H
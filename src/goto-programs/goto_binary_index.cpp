@@ -0,0 +1,228 @@
+#include <cstring>
+#include <goto-programs/goto_binary_index.h>
+#include <goto-programs/goto_program_irep.h>
+#include <goto-programs/write_goto_binary.h>
+#include <util/message.h>
+
+bool goto_binary_indext::is_indexed(const void *data, size_t size)
+{
+  const unsigned char *b = static_cast<const unsigned char *>(data);
+  if (size < 7 || memcmp(b, "GBF", 3) != 0)
+    return false;
+
+  // The version is written big endian by write_long
+  uint32_t version = uint32_t(b[3]) << 24 | uint32_t(b[4]) << 16 |
+                     uint32_t(b[5]) << 8 | uint32_t(b[6]);
+  return version == GOTO_BINARY_VERSION;
+}
+
+uint32_t goto_binary_indext::word(size_t pos) const
+{
+  assert(pos + 4 <= size);
+  const unsigned char *p = bytes + pos;
+  return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 |
+         uint32_t(p[3]) << 24;
+}
+
+bool goto_binary_indext::load(const void *data, size_t data_size)
+{
+  bytes = static_cast<const unsigned char *>(data);
+  size = data_size;
+
+  if (!is_indexed(data, size))
+  {
+    log_error("not a goto-binary of version {}", GOTO_BINARY_VERSION);
+    return true;
+  }
+
+  if (size < GOTO_BINARY_HEADER_SIZE)
+  {
+    log_error("truncated goto-binary");
+    return true;
+  }
+
+  n_strings = word(8);
+  n_ireps = word(12);
+  uint32_t n_symbols = word(16);
+  uint32_t n_functions = word(20);
+
+  // Sections follow each other in this order; positions are computed in 64
+  // bits so that corrupt counts can't wrap around
+  uint64_t pos = GOTO_BINARY_HEADER_SIZE;
+  string_offsets = pos;
+  pos += 4 * (uint64_t(n_strings) + 1);
+  irep_offsets = pos;
+  pos += 4 * uint64_t(n_ireps);
+  uint64_t symbols_pos = pos;
+  pos += 12 * uint64_t(n_symbols);
+  uint64_t functions_pos = pos;
+  pos += 8 * uint64_t(n_functions);
+  if (pos > size)
+  {
+    log_error("truncated goto-binary");
+    return true;
+  }
+
+  string_data = pos;
+  pos += (uint64_t(word(string_offsets + 4 * size_t(n_strings))) + 3) & ~3;
+  if (pos > size)
+  {
+    log_error("truncated goto-binary");
+    return true;
+  }
+  irep_data = pos;
+
+  strings.assign(n_strings, irep_idt());
+  have_string.assign(n_strings, false);
+  ireps.assign(n_ireps, irept());
+  have_irep.assign(n_ireps, false);
+
+  symbol_entries.clear();
+  function_entries.clear();
+  symbol_lookup.clear();
+  function_lookup.clear();
+
+  symbol_entries.reserve(n_symbols);
+  for (uint32_t i = 0; i < n_symbols; i++)
+  {
+    size_t p = symbols_pos + 12 * size_t(i);
+    if (
+      word(p) >= n_strings || word(p + 4) >= n_strings ||
+      word(p + 8) >= n_ireps)
+    {
+      log_error("corrupt goto-binary symbol table");
+      return true;
+    }
+
+    symbol_entries.push_back(
+      {string(word(p)), string(word(p + 4)), word(p + 8)});
+    symbol_lookup.emplace(symbol_entries.back().name, i);
+  }
+
+  function_entries.reserve(n_functions);
+  for (uint32_t i = 0; i < n_functions; i++)
+  {
+    size_t p = functions_pos + 8 * size_t(i);
+    if (word(p) >= n_strings || word(p + 4) >= n_ireps)
+    {
+      log_error("corrupt goto-binary function table");
+      return true;
+    }
+
+    function_entries.push_back({string(word(p)), irep_idt(), word(p + 4)});
+    function_lookup.emplace(function_entries.back().name, i);
+  }
+
+  return false;
+}
+
+const goto_binary_indext::entryt *
+goto_binary_indext::find_symbol(const irep_idt &id) const
+{
+  auto it = symbol_lookup.find(id);
+  if (it == symbol_lookup.end())
+    return nullptr;
+  return &symbol_entries[it->second];
+}
+
+const goto_binary_indext::entryt *
+goto_binary_indext::find_function(const irep_idt &id) const
+{
+  auto it = function_lookup.find(id);
+  if (it == function_lookup.end())
+    return nullptr;
+  return &function_entries[it->second];
+}
+
+void goto_binary_indext::read_symbol(const entryt &entry, symbolt &symbol)
+{
+  symbol.from_irep(irep(entry.irep));
+}
+
+void goto_binary_indext::read_function(
+  const entryt &entry,
+  goto_programt &body)
+{
+  convert(irep(entry.irep), body);
+}
+
+const irep_idt &goto_binary_indext::string(uint32_t n)
+{
+  assert(n < n_strings);
+  if (have_string[n])
+    return strings[n];
+
+  uint32_t begin = word(string_offsets + 4 * size_t(n));
+  uint32_t end = word(string_offsets + 4 * size_t(n) + 4);
+  if (begin > end || string_data + end > irep_data)
+  {
+    log_error("corrupt goto-binary string table");
+    abort();
+  }
+
+  const char *s = reinterpret_cast<const char *>(bytes + string_data + begin);
+  strings[n] = irep_idt(std::string(s, end - begin));
+  have_string[n] = true;
+  return strings[n];
+}
+
+const irept &goto_binary_indext::irep(uint32_t n)
+{
+  assert(n < n_ireps);
+  if (have_irep[n])
+    return ireps[n];
+
+  // A node is its id, the number of operands, named and comment
+  // subtrees, followed by the operand irep numbers and the (name, irep)
+  // pairs of the named subtrees and comments
+  uint64_t pos = irep_data + 4 * uint64_t(word(irep_offsets + 4 * size_t(n)));
+  if (pos + 16 > size)
+  {
+    log_error("corrupt goto-binary irep table");
+    abort();
+  }
+
+  uint32_t id = word(pos);
+  uint32_t n_sub = word(pos + 4);
+  uint64_t n_named = word(pos + 8) + uint64_t(word(pos + 12));
+  uint64_t end = pos + 16 + 4 * (uint64_t(n_sub) + 2 * uint64_t(n_named));
+  if (end > size || id >= n_strings)
+  {
+    log_error("corrupt goto-binary irep table");
+    abort();
+  }
+
+  // Subtrees are written before the nodes using them, which also rules out
+  // cycles in corrupt input
+  auto child = [this, n](uint32_t c) -> const irept & {
+    if (c >= n)
+    {
+      log_error("corrupt goto-binary irep table");
+      abort();
+    }
+    return irep(c);
+  };
+
+  irept r(string(id));
+  pos += 16;
+
+  irept::subt &sub = r.get_sub();
+  sub.reserve(n_sub);
+  for (uint32_t i = 0; i < n_sub; i++, pos += 4)
+    sub.push_back(child(word(pos)));
+
+  for (uint64_t i = 0; i < n_named; i++, pos += 8)
+  {
+    uint32_t name = word(pos);
+    if (name >= n_strings)
+    {
+      log_error("corrupt goto-binary irep table");
+      abort();
+    }
+    r.add(string(name)) = child(word(pos + 4));
+  }
+
+  ireps[n] = std::move(r);
+  have_irep[n] = true;
+  return ireps[n];
+}
@@ -0,0 +1,85 @@
+#ifndef CPROVER_GOTO_PROGRAMS_GOTO_BINARY_INDEX_H_
+#define CPROVER_GOTO_PROGRAMS_GOTO_BINARY_INDEX_H_
+
+#include <cstdint>
+#include <goto-programs/goto_functions.h>
+#include <unordered_map>
+#include <util/irep.h>
+#include <util/symbol.h>
+#include <vector>
+
+/**
+ * @brief Random access to the symbols and functions of a goto-binary held
+ * in memory, e.g. mapped from a file or embedded in the executable.
+ *
+ * The binary (see write_goto_binary) consists of a string table, the DAG of
+ * all ireps in the program, each stored once, and sections listing the
+ * symbols and function bodies by the index of their irep. All of it is
+ * addressed by offsets, so loading only checks the section bounds and reads
+ * the symbol list; ireps and strings are built when first asked for, and
+ * ireps shared in the binary are shared in memory as well.
+ */
+class goto_binary_indext
+{
+public:
+  struct entryt
+  {
+    irep_idt name;
+    /// Function the symbol was declared in, see symbolt::get_function_name
+    irep_idt function;
+    uint32_t irep;
+  };
+
+  /**
+   * Parses the header and symbol list of the goto-binary in `data`, which
+   * must outlive this object.
+   * @return true on error, false on success */
+  bool load(const void *data, size_t size);
+
+  /// Whether `data` starts with the header of the format read by load()
+  static bool is_indexed(const void *data, size_t size);
+
+  const std::vector<entryt> &symbols() const
+  {
+    return symbol_entries;
+  }
+
+  const std::vector<entryt> &functions() const
+  {
+    return function_entries;
+  }
+
+  /// Index entry of the symbol `id`, or nullptr
+  const entryt *find_symbol(const irep_idt &id) const;
+
+  /// Index entry of the body of function `id`, or nullptr
+  const entryt *find_function(const irep_idt &id) const;
+
+  void read_symbol(const entryt &entry, symbolt &symbol);
+  void read_function(const entryt &entry, goto_programt &body);
+
+private:
+  const unsigned char *bytes = nullptr;
+  size_t size = 0;
+
+  uint32_t n_strings = 0, n_ireps = 0;
+  size_t string_offsets = 0, irep_offsets = 0;
+  size_t string_data = 0, irep_data = 0;
+
+  std::vector<entryt> symbol_entries;
+  std::vector<entryt> function_entries;
+  std::unordered_map<irep_idt, size_t, irep_id_hash> symbol_lookup;
+  std::unordered_map<irep_idt, size_t, irep_id_hash> function_lookup;
+
+  // Strings and ireps built so far, by their number in the binary
+  std::vector<irep_idt> strings;
+  std::vector<bool> have_string;
+  std::vector<irept> ireps;
+  std::vector<bool> have_irep;
+
+  uint32_t word(size_t pos) const;
+  const irep_idt &string(uint32_t n);
+  const irept &irep(uint32_t n);
+};
+
+#endif
@@ -3,8 +3,8 @@
 #include <goto-programs/goto_functions.h>
 #include <util/message.h>
 #include <fstream>
-#include <boost/iostreams/device/array.hpp>
-#include <boost/iostreams/stream.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 
 bool goto_binary_reader::read_goto_binary_array(
   const void *data,
@@ -12,9 +12,7 @@ bool goto_binary_reader::read_goto_binary_array(
   contextt &context,
   goto_functionst &dest)
 {
-  using namespace boost::iostreams;
-  stream<array_source> src(static_cast<const char *>(data), size);
-  return read_bin_goto_object(src, "", context, functions, dest);
+  return read_bin_goto_object(data, size, "", context, functions, dest);
 }
 
 bool goto_binary_reader::read_goto_binary(
@@ -22,6 +20,54 @@ bool goto_binary_reader::read_goto_binary(
   contextt &context,
   goto_functionst &dest)
 {
+  std::vector<std::string> all;
+
+  // Map the file so that it is read in place rather than copied; empty
+  // files can't be mapped and are left to the stream reader to reject
+  boost::system::error_code ec;
+  auto size = boost::filesystem::file_size(path, ec);
+  if (!ec && size > 0)
+  {
+    boost::iostreams::mapped_file_source file;
+    try
+    {
+      file.open(path);
+    }
+    catch (const std::exception &e)
+    {
+      log_error("Failed to map `{}': {}", path, e.what());
+      return true;
+    }
+    return read_bin_goto_object(
+      file.data(), file.size(), path, context, all, entry_points, dest);
+  }
+
   std::ifstream in(path, std::ios::in | std::ios::binary);
+  if (!in)
+    return true;
   return read_bin_goto_object(in, path, context, dest);
 }
+
+bool goto_binary_reader::read_goto_binaries(
+  const std::vector<std::string> &paths,
+  contextt &context,
+  goto_functionst &dest)
+{
+  std::vector<std::string> saved_entry_points = entry_points;
+  if (paths.size() > 1)
+    entry_points.clear();
+
+  bool failed = false;
+  for (const auto &path : paths)
+  {
+    if (read_goto_binary(path, context, dest))
+    {
+      log_error("Failed to open `{}'", path);
+      failed = true;
+      break;
+    }
+  }
+
+  entry_points = saved_entry_points;
+  return failed;
+}
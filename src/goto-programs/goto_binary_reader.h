@@ -21,11 +21,27 @@ public:
     functions = funcs;
   }
 
+  /// Functions the program starts from, see read_bin_goto_object
+  void set_entry_points(const std::vector<std::string> &funcs)
+  {
+    entry_points = funcs;
+  }
+
   bool read_goto_binary(
     const std::string &path,
     contextt &context,
     goto_functionst &dest);
 
+  /// Reads and links the binaries in `paths`. The entry points only limit
+  /// the bodies decoded when there is a single binary: with several, a
+  /// function may only be called from another binary, so all are decoded.
+  /// @return true on error, false on success
+  bool read_goto_binaries(
+    const std::vector<std::string> &paths,
+    contextt &context,
+    goto_functionst &dest);
+
 private:
   std::vector<std::string> functions; // functions to read
+  std::vector<std::string> entry_points;
 };
@@ -1,13 +1,95 @@
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <goto-programs/goto_binary_index.h>
 #include <goto-programs/goto_function_serialization.h>
 #include <goto-programs/goto_program_irep.h>
 #include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
 #include <langapi/mode.h>
 #include <util/base_type.h>
 #include <util/irep_serialization.h>
 #include <util/namespace.h>
+#include <util/prefix.h>
 #include <util/symbol_serialization.h>
+#include <unordered_set>
 
-#define BINARY_VERSION 1
+static void add_symbol(
+  const symbolt &symbol,
+  contextt &context,
+  const std::vector<std::string> &functions,
+  goto_functionst &goto_functions)
+{
+  if (!symbol.is_type && symbol.type.is_code())
+  {
+    // makes sure there is an empty function
+    // for every function symbol and fixes
+    // the function types.
+    auto it = goto_functions.function_map.find(symbol.id);
+    if (it == goto_functions.function_map.end())
+      goto_functions.function_map.emplace(symbol.id, goto_functiont());
+    goto_functions.function_map.at(symbol.id).type = to_code_type(symbol.type);
+  }
+
+  // Add functions only from the list
+  if (!functions.empty())
+  {
+    auto it = std::find(
+      functions.begin(), functions.end(), symbol.get_function_name().c_str());
+    if (it == functions.end())
+      return;
+  }
+
+  context.add(symbol);
+}
+
+static goto_functiont &
+function_body(const irep_idt &fname, goto_functionst &goto_functions)
+{
+  auto it = goto_functions.function_map.find(fname);
+  if (it == goto_functions.function_map.end())
+    it = goto_functions.function_map.emplace(fname, goto_functiont()).first;
+  return it->second;
+}
+
+/* Version 1 binaries are a stream of ireps referring back to the ones read
+ * before, so they can only be read front to back. */
+static bool read_bin_goto_object_v1(
+  std::istream &in,
+  contextt &context,
+  const std::vector<std::string> &functions,
+  goto_functionst &goto_functions)
+{
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+  symbol_serializationt symbolconverter(ic);
+  goto_function_serializationt gfconverter(ic);
+
+  unsigned count = irepconverter.read_long(in);
+
+  for (unsigned i = 0; i < count; i++)
+  {
+    irept t;
+    symbolconverter.convert(in, t);
+    symbolt symbol;
+    symbol.from_irep(t);
+    add_symbol(symbol, context, functions, goto_functions);
+  }
+
+  assert(migrate_namespace_lookup);
+
+  count = irepconverter.read_long(in);
+  for (unsigned i = 0; i < count; i++)
+  {
+    irept t;
+    dstring fname = irepconverter.read_string(in);
+    gfconverter.convert(in, t);
+    goto_functiont &f = function_body(fname, goto_functions);
+    convert(t, f.body);
+    f.body_available = f.body.instructions.size() > 0;
+  }
+
+  return false;
+}
 
 bool read_bin_goto_object(
   std::istream &in,
@@ -44,70 +126,127 @@ bool read_bin_goto_object(
     }
   }
 
-  irep_serializationt::ireps_containert ic;
-  irep_serializationt irepconverter(ic);
-  symbol_serializationt symbolconverter(ic);
-  goto_function_serializationt gfconverter(ic);
+  unsigned version = irep_serializationt::read_long(in);
 
+  if (version == 1)
+    return read_bin_goto_object_v1(in, context, functions, goto_functions);
+
+  if (version != GOTO_BINARY_VERSION)
   {
-    unsigned version = irepconverter.read_long(in);
+    str << "The input was compiled with a different version of "
+        << "goto-cc, please recompile";
+    log_error("{}", str.str());
+    abort();
+  }
 
-    if (version != BINARY_VERSION)
-    {
-      str << "The input was compiled with a different version of "
-          << "goto-cc, please recompile";
-      log_error("{}", str.str());
-      abort();
-    }
+  // Put the header back, the indexed reader works on the whole binary
+  std::ostringstream data;
+  data << "GBF";
+  write_long(data, version);
+  data << in.rdbuf();
+  std::string buffer = data.str();
+
+  return read_bin_goto_object(
+    buffer.data(), buffer.size(), filename, context, functions, goto_functions);
+}
+
+/* Collects the ids of all symbols `e` refers to. */
+static void collect_symbols(const expr2tc &e, std::vector<irep_idt> &ids)
+{
+  if (is_nil_expr(e))
+    return;
+
+  if (is_symbol2t(e))
+  {
+    ids.push_back(to_symbol2t(e).thename);
+    return;
   }
 
-  unsigned count = irepconverter.read_long(in);
+  e->foreach_operand([&ids](const expr2tc &op) { collect_symbols(op, ids); });
+}
 
-  for (unsigned i = 0; i < count; i++)
+bool read_bin_goto_object(
+  const void *data,
+  size_t size,
+  const std::string &filename,
+  contextt &context,
+  std::vector<std::string> &functions,
+  goto_functionst &goto_functions)
+{
+  std::vector<std::string> entry_points;
+  return read_bin_goto_object(
+    data, size, filename, context, functions, entry_points, goto_functions);
+}
+
+bool read_bin_goto_object(
+  const void *data,
+  size_t size,
+  const std::string &filename,
+  contextt &context,
+  std::vector<std::string> &functions,
+  const std::vector<std::string> &entry_points,
+  goto_functionst &goto_functions)
+{
+  if (!goto_binary_indext::is_indexed(data, size))
   {
-    irept t;
-    symbolconverter.convert(in, t);
-    symbolt symbol;
-    symbol.from_irep(t);
+    using namespace boost::iostreams;
+    stream<array_source> in(static_cast<const char *>(data), size);
+    return read_bin_goto_object(
+      in, filename, context, functions, goto_functions);
+  }
 
-    if (!symbol.is_type && symbol.type.is_code())
-    {
-      // makes sure there is an empty function
-      // for every function symbol and fixes
-      // the function types.
-      auto it = goto_functions.function_map.find(symbol.id);
-      if (it == goto_functions.function_map.end())
-        goto_functions.function_map.emplace(symbol.id, goto_functiont());
-      goto_functions.function_map.at(symbol.id).type =
-        to_code_type(symbol.type);
-    }
+  goto_binary_indext index;
+  if (index.load(data, size))
+    return true;
 
-    // Add functions only from the list
-    if (!functions.empty())
-    {
-      auto it = std::find(
-        functions.begin(), functions.end(), symbol.get_function_name().c_str());
-      if (it == functions.end())
-        continue;
-    }
+  for (const goto_binary_indext::entryt &e : index.symbols())
+  {
+    // Symbols declared in functions that aren't read are never built; the
+    // functions themselves are, for add_symbol to record their types
+    bool is_function = has_suffix(e.name, "F@" + e.function.as_string());
+    if (
+      !is_function && !functions.empty() &&
+      std::find(functions.begin(), functions.end(), e.function.as_string()) ==
+        functions.end())
+      continue;
 
-    context.add(symbol);
+    symbolt symbol;
+    index.read_symbol(e, symbol);
+    add_symbol(symbol, context, functions, goto_functions);
   }
 
   assert(migrate_namespace_lookup);
 
-  count = irepconverter.read_long(in);
-  for (unsigned i = 0; i < count; i++)
+  /* Bodies are decoded starting from the entry points, following the
+   * functions each decoded body refers to, so that the bodies of functions
+   * the program never reaches, e.g. of unused library functions, aren't
+   * built. Without an entry point in this binary, all bodies are read. */
+  std::vector<irep_idt> to_read;
+  for (const std::string &id : entry_points)
+    if (index.find_function(id))
+      to_read.push_back(id);
+  if (to_read.empty())
+    for (const goto_binary_indext::entryt &e : index.functions())
+      to_read.push_back(e.name);
+
+  std::unordered_set<irep_idt, irep_id_hash> read;
+  while (!to_read.empty())
   {
-    irept t;
-    dstring fname = irepconverter.read_string(in);
-    gfconverter.convert(in, t);
-    auto it = goto_functions.function_map.find(fname);
-    if (it == goto_functions.function_map.end())
-      goto_functions.function_map.emplace(fname, goto_functiont());
-    goto_functiont &f = goto_functions.function_map.at(fname);
-    convert(t, f.body);
+    irep_idt name = to_read.back();
+    to_read.pop_back();
+    const goto_binary_indext::entryt *e = index.find_function(name);
+    if (!e || !read.insert(name).second)
+      continue;
+
+    goto_functiont &f = function_body(name, goto_functions);
+    index.read_function(*e, f.body);
     f.body_available = f.body.instructions.size() > 0;
+
+    for (const goto_programt::instructiont &i : f.body.instructions)
+    {
+      collect_symbols(i.code, to_read);
+      collect_symbols(i.guard, to_read);
+    }
   }
 
   return false;
@@ -22,4 +22,27 @@ bool read_bin_goto_object(
   std::vector<std::string> &functions,
   goto_functionst &goto_functions);
 
+/** As above, for a goto-binary in memory. Current binaries are read in
+ *  place, without copying `data`. */
+bool read_bin_goto_object(
+  const void *data,
+  size_t size,
+  const std::string &filename,
+  contextt &context,
+  std::vector<std::string> &functions,
+  goto_functionst &goto_functions);
+
+/** As above, decoding only the bodies of the functions in `entry_points`
+ *  and of those their bodies refer to. All bodies are decoded if none of
+ *  `entry_points` is defined in the binary, or if it is an old binary
+ *  that can only be read as a whole. */
+bool read_bin_goto_object(
+  const void *data,
+  size_t size,
+  const std::string &filename,
+  contextt &context,
+  std::vector<std::string> &functions,
+  const std::vector<std::string> &entry_points,
+  goto_functionst &goto_functions);
+
 #endif /*READ_BIN_GOTO_OBJECT_H_*/
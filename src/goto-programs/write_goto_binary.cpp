@@ -1,49 +1,134 @@
-#include <fstream>
-#include <goto-programs/goto_function_serialization.h>
+#include <cstdint>
+#include <goto-programs/goto_program_irep.h>
 #include <goto-programs/write_goto_binary.h>
+#include <unordered_map>
 #include <util/irep_serialization.h>
 #include <util/message.h>
-#include <util/symbol_serialization.h>
+#include <vector>
+
+namespace
+{
+/* Collects the string table and the irep DAG of a goto-binary */
+class goto_binary_buildert
+{
+public:
+  uint32_t string(const irep_idt &s)
+  {
+    auto [it, inserted] = string_numbers.try_emplace(s.get_no(), 0);
+    if (inserted)
+    {
+      it->second = string_offsets.size() - 1;
+      string_data += s.as_string();
+      string_offsets.push_back(string_data.size());
+    }
+    return it->second;
+  }
+
+  uint32_t irep(const irept &i)
+  {
+    auto found = irep_numbers.find(i);
+    if (found != irep_numbers.end())
+      return found->second;
+
+    // Subtrees first, so that a node's record is contiguous
+    std::vector<uint32_t> node;
+    node.push_back(string(i.id()));
+    node.push_back(i.get_sub().size());
+    node.push_back(i.get_named_sub().size());
+    node.push_back(i.get_comments().size());
+
+    forall_irep (it, i.get_sub())
+      node.push_back(irep(*it));
+
+    for (const auto *subs : {&i.get_named_sub(), &i.get_comments()})
+      forall_named_irep (it, *subs)
+      {
+        node.push_back(string(name2string(it->first)));
+        node.push_back(irep(it->second));
+      }
+
+    uint32_t n = irep_offsets.size();
+    irep_offsets.push_back(irep_data.size());
+    irep_data.insert(irep_data.end(), node.begin(), node.end());
+    irep_numbers.emplace(i, n);
+    return n;
+  }
+
+  std::vector<uint32_t> string_offsets{0};
+  std::string string_data;
+  std::vector<uint32_t> irep_offsets;
+  std::vector<uint32_t> irep_data;
+
+private:
+  std::unordered_map<unsigned, uint32_t> string_numbers;
+  std::unordered_map<irept, uint32_t, irep_full_hash, irep_full_eq>
+    irep_numbers;
+};
+
+void write_word(std::ostream &out, uint32_t w)
+{
+  out.put(w & 0xFF);
+  out.put((w >> 8) & 0xFF);
+  out.put((w >> 16) & 0xFF);
+  out.put((w >> 24) & 0xFF);
+}
+
+void write_words(std::ostream &out, const std::vector<uint32_t> &ws)
+{
+  for (uint32_t w : ws)
+    write_word(out, w);
+}
+} // namespace
 
 bool write_goto_binary(
   std::ostream &out,
   const contextt &lcontext,
   goto_functionst &functions)
 {
-  // header
-  out << "GBF";
-  write_long(out, GOTO_BINARY_VERSION);
-
-  irep_serializationt::ireps_containert irepc;
-  irep_serializationt irepconverter(irepc);
-  symbol_serializationt symbolconverter(irepc);
-  goto_function_serializationt gfconverter(irepc);
-
-  write_long(out, lcontext.size());
+  goto_binary_buildert builder;
 
-  lcontext.foreach_operand([&symbolconverter, &out](const symbolt &s) {
-    symbolconverter.convert(s, out);
+  std::vector<uint32_t> symbols;
+  lcontext.foreach_operand([&builder, &symbols](const symbolt &s) {
+    irept t;
+    s.to_irep(t);
+    symbols.push_back(builder.string(s.id));
+    symbols.push_back(builder.string(s.get_function_name()));
+    symbols.push_back(builder.irep(t));
   });
 
-  unsigned cnt = 0;
-  forall_goto_functions (it, functions)
-    if (it->second.body_available)
-      cnt++;
-
-  write_long(out, cnt);
-
+  std::vector<uint32_t> bodies;
   for (auto &it : functions.function_map)
   {
     if (it.second.body_available)
     {
       it.second.body.compute_location_numbers();
-      write_string(out, it.first.as_string());
-      gfconverter.convert(it.second, out);
+      irept t;
+      convert(it.second.body, t);
+      bodies.push_back(builder.string(it.first));
+      bodies.push_back(builder.irep(t));
     }
   }
 
-  //irepconverter.output_map(f);
-  //irepconverter.output_string_map(f);
+  // header
+  out << "GBF";
+  write_long(out, GOTO_BINARY_VERSION);
+  out.put(0);
+
+  write_word(out, builder.string_offsets.size() - 1);
+  write_word(out, builder.irep_offsets.size());
+  write_word(out, symbols.size() / 3);
+  write_word(out, bodies.size() / 2);
+
+  write_words(out, builder.string_offsets);
+  write_words(out, builder.irep_offsets);
+  write_words(out, symbols);
+  write_words(out, bodies);
+
+  out << builder.string_data;
+  for (size_t i = builder.string_data.size(); i % 4 != 0; i++)
+    out.put(0);
+
+  write_words(out, builder.irep_data);
 
-  return false;
+  return !out.good();
 }
@@ -1,7 +1,20 @@
 #ifndef CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H_
 #define CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H_
 
-#define GOTO_BINARY_VERSION 1
+/* Version 3 is laid out to be used in place, e.g. mapped from a file, see
+ * goto_binary_indext. After "GBF", the big endian version and a padding
+ * byte, every field is a 32-bit little endian word:
+ *  - the number of strings, ireps, symbols and functions
+ *  - string offsets into the string data, one more than there are strings
+ *  - irep offsets into the irep data, in words
+ *  - per symbol: its name, the function declaring it (string numbers) and
+ *    its irep number
+ *  - per function body: its name and its irep number
+ *  - the string data, padded to a multiple of four bytes
+ *  - the irep data. Each distinct irep is stored once, after its subtrees.
+ */
+#define GOTO_BINARY_VERSION 3
+#define GOTO_BINARY_HEADER_SIZE 24
 
 #include <goto-programs/goto_functions.h>
 #include <ostream>
@@ -17,8 +17,8 @@
 #include <util/string2array.h>
 #include <vector>
 
-unsigned int execution_statet::node_count = 0;
-unsigned int execution_statet::dynamic_counter = 0;
+thread_local unsigned int execution_statet::node_count = 0;
+thread_local unsigned int execution_statet::dynamic_counter = 0;
 
 execution_statet::execution_statet(
   const goto_functionst &goto_functions,
@@ -201,6 +201,11 @@ void execution_statet::symex_step(reachability_treet &art)
   const goto_programt::instructiont &instruction = *state.source.pc;
   last_insn = &instruction;
 
+  // Snapshot the state before anything bound-dependent is encoded, so that
+  // the next (larger) bound can resume from here.
+  if (art.keep_frontier && !art.frontier_reached && at_unwind_frontier())
+    art.record_unwind_frontier(*this);
+
   merge_gotos();
 
   // If current state guard is false, it shouldn't perform further context switch.
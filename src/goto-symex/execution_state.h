@@ -537,8 +537,9 @@ public:
   irep_idt guard_execution;
   /** Number of nondeterministic symbols in this state. */
   unsigned nondet_count;
-  /** Number of dynamic objects in this state. */
-  static unsigned dynamic_counter;
+  /** Number of dynamic objects in this state. Per thread, since parallel
+   *  k-induction runs symex on several threads at once. */
+  static thread_local unsigned dynamic_counter;
   /** Identifying number for this execution state. Used to distinguish runs
    *  in --schedule mode. */
   unsigned int node_id;
@@ -603,7 +604,7 @@ protected:
   // Static stuff:
 
 public:
-  static unsigned int node_count;
+  static thread_local unsigned int node_count;
 
   friend void build_goto_symex_classes();
 };
@@ -1,19 +1,34 @@
 #include "irep2/irep2_type.h"
 #include <goto-symex/features.h>
+#include <algorithm>
 
 bool ssa_features::run(symex_target_equationt::SSA_stepst &steps)
+{
+  collect(steps, false);
+  print_result();
+
+  return false;
+}
+
+void ssa_features::collect(
+  const symex_target_equationt::SSA_stepst &steps,
+  bool skip_ignored)
 {
   features.clear();
+  visited.clear();
+  this->steps = nodes = depth = 0;
 
   for (const auto &step : steps)
   {
+    if (skip_ignored && step.ignore)
+      continue;
+
+    ++this->steps;
     for (const expr2tc &e : std::array{step.cond, step.guard})
       check(e);
   }
 
-  print_result();
-
-  return false;
+  visited.clear();
 }
 
 void ssa_features::check(const expr2tc &e)
@@ -21,13 +36,61 @@ void ssa_features::check(const expr2tc &e)
   if (!e)
     return;
 
-  // TODO: We could add a cache
+  std::vector<std::pair<const expr2tc *, bool>> stack = {{&e, false}};
+  while (!stack.empty())
+  {
+    const expr2tc &top = *stack.back().first;
+    if (visited.count(top.get()))
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    if (stack.back().second)
+    {
+      stack.pop_back();
+      visit(top);
+      continue;
+    }
+
+    stack.back().second = true;
+    top->foreach_operand([this, &stack](const expr2tc &op) {
+      if (op && !visited.count(op.get()))
+        stack.emplace_back(&op, false);
+    });
+  }
+
+  depth = std::max(depth, visited.at(e.get()).height);
+}
+
+void ssa_features::visit(const expr2tc &e)
+{
+  ++nodes;
+
+  size_t height = 0;
+  bool constant = true;
+  e->foreach_operand([this, &height, &constant](const expr2tc &op) {
+    if (!op)
+      return;
+    const nodet &n = visited.at(op.get());
+    height = std::max(height, n.height);
+    constant &= n.constant;
+  });
+
+  if (is_constant_expr(e))
+    constant = true;
+  else if (is_pointer_type(e))
+    constant = false;
+
   if (is_array_type(e->type))
     features.insert(SSA_FEATURES::ARRAY);
 
   if (is_struct_type(e->type))
     features.insert(SSA_FEATURES::STRUCTS);
 
+  if (is_floatbv_type(e->type))
+    features.insert(SSA_FEATURES::FLOATING_POINT);
+
   switch (e->expr_id)
   {
   case expr2t::constant_fixedbv_id:
@@ -41,8 +104,6 @@ void ssa_features::check(const expr2tc &e)
   {
     // TODO: We should deal with some non-linearity here e.g.: division-by-zero
     const auto &arith_op = dynamic_cast<const arith_2ops &>(*e);
-    const expr2tc side_1 = arith_op.side_1;
-    const expr2tc side_2 = arith_op.side_2;
     if (
       !is_entirely_constant(arith_op.side_1) &&
       !is_entirely_constant(arith_op.side_2))
@@ -74,13 +135,14 @@ void ssa_features::check(const expr2tc &e)
   case expr2t::overflow_id:
   case expr2t::overflow_neg_id:
     features.insert(SSA_FEATURES::OVERFLOW_ASSERTIONS);
+    constant = false;
     break;
 
   default:
     break;
   }
 
-  e->foreach_operand([this](const expr2tc &next) { check(next); });
+  visited.emplace(e.get(), nodet{height + 1, constant});
 }
 
 void ssa_features::print_result() const
@@ -97,31 +159,13 @@ void ssa_features::print_result() const
     log_status("SSA: Contains ARRAY");
   if (features.count(SSA_FEATURES::STRUCTS))
     log_status("SSA: Contains STRUCTS");
+  if (features.count(SSA_FEATURES::FLOATING_POINT))
+    log_status("SSA: Contains FLOATING POINT");
+  log_status("SSA: {} steps, {} nodes, depth {}", steps, nodes, depth);
 }
 
-bool ssa_features::is_entirely_constant(const expr2tc &e)
+bool ssa_features::is_entirely_constant(const expr2tc &e) const
 {
-  if (is_constant_expr(e))
-    return true;
-
-  if (is_pointer_type(e))
-    return false;
-
-  switch (e->expr_id)
-  {
-  case expr2t::overflow_cast_id:
-  case expr2t::overflow_id:
-  case expr2t::overflow_neg_id:
-    return false;
-
-  default:
-    break;
-  }
-
-  bool result = true;
-  e->foreach_operand([this, &result](const expr2tc &next) {
-    result &= is_entirely_constant(next);
-  });
-
-  return result;
+  // Operands are visited before the expressions using them
+  return !e || visited.at(e.get()).constant;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <unordered_map>
 #include <unordered_set>
 #include <util/algorithms.h>
 #include <goto-symex/symex_target_equation.h>
@@ -11,7 +12,8 @@ enum class SSA_FEATURES
   BITWISE_OPERATIONS,
   OVERFLOW_ASSERTIONS,
   ARRAY,
-  STRUCTS
+  STRUCTS,
+  FLOATING_POINT
 };
 
 class ssa_features : public ssa_step_algorithm
@@ -20,7 +22,21 @@ public:
   ssa_features() : ssa_step_algorithm(false){};
   bool run(symex_target_equationt::SSA_stepst &) override;
 
+  /// Collects the features and metrics of the steps, without printing them.
+  /// With `skip_ignored`, steps that slicing ignored are left out.
+  void collect(
+    const symex_target_equationt::SSA_stepst &steps,
+    bool skip_ignored = true);
+
   std::unordered_set<SSA_FEATURES> features;
+  /// Steps looked at
+  size_t steps = 0;
+  /// Distinct expression nodes in their guards and conditions, shared ones
+  /// counted once
+  size_t nodes = 0;
+  /// Depth of the deepest of these expressions
+  size_t depth = 0;
+
   void print_result() const;
 
   BigInt ignored() const override
@@ -29,7 +45,22 @@ public:
   }
 
 protected:
+  struct nodet
+  {
+    size_t height;
+    /* Whether the expression only has constant leaves */
+    bool constant;
+  };
+
+  /* Expressions already walked, so that shared ones are walked once */
+  std::unordered_map<const expr2t *, nodet> visited;
+
+  /* Walks `e` in post-order with an explicit stack, as phi functions build
+   * if-then-else chains too deep to recurse over. */
   void check(const expr2tc &e);
 
-  bool is_entirely_constant(const expr2tc &e);
+  /* Records the features of `e`, whose operands are all visited */
+  void visit(const expr2tc &e);
+
+  bool is_entirely_constant(const expr2tc &e) const;
 };
@@ -76,6 +76,19 @@ public:
 
   typedef goto_symex_statet statet;
 
+  /** Cost of joining states at merge points */
+  struct merge_statst
+  {
+    /** Number of goto states merged into the current state */
+    unsigned long joins = 0;
+    /** Variables whose renaming phi_function compared between the states */
+    unsigned long phi_visited = 0;
+    /** Variables a full scan of the level2 tables would have compared */
+    unsigned long phi_total = 0;
+    /** Phi assignments generated */
+    unsigned long phi_assignments = 0;
+  };
+
   /**
    *  Class recording the outcome of symbolic execution.
    *  Contains the things that are of interest to the BMC class: The object
@@ -95,6 +108,7 @@ public:
     std::shared_ptr<symex_targett> target;
     unsigned int total_claims;
     unsigned int remaining_claims;
+    merge_statst merge_stats;
   };
 
   // Macros
@@ -288,6 +302,15 @@ protected:
    */
   bool get_unwind(const symex_targett::sourcet &source, const BigInt &unwind);
 
+  /**
+   *  Test whether the current instruction is the first one whose effect
+   *  depends on the unwinding bound, i.e. it would be interpreted differently
+   *  had max_unwind been larger. Everything symex produced before this point
+   *  is identical for any larger bound.
+   *  @return True if the current instruction hits the unwinding bound.
+   */
+  bool at_unwind_frontier() const;
+
   /**
    *  Encode unwinding assertions and assumption.
    *  If unwinding assertions are on, assert that the unwinding bound is not
@@ -864,6 +887,8 @@ protected:
   unsigned total_claims;
   /** Number of assertions remaining to be discharged. */
   unsigned remaining_claims;
+  /** Merge point costs, see merge_statst. */
+  merge_statst merge_stats;
   /** Reachability tree we're working with. */
   reachability_treet *art1;
   /** Unwind bounds, loop number -> max unwinds. */
@@ -46,6 +46,14 @@ reachability_treet::reachability_treet(
   target_template = std::move(target);
 }
 
+reachability_treet::~reachability_treet()
+{
+  // Value sets hand their object numbers back when destroyed
+  value_sett::numbering_scopet numbering(value_set_numbering);
+  execution_states.clear();
+  unwind_frontier.reset();
+}
+
 void reachability_treet::setup_for_new_explore()
 {
   std::shared_ptr<symex_targett> targ;
@@ -80,6 +88,71 @@ void reachability_treet::setup_for_new_explore()
   execution_states.emplace_back(s);
   cur_state_it = execution_states.begin();
   targ->push_ctx(); // Start with a depth of 1.
+
+  main_thread_ended = false;
+  frontier_reached = false;
+  unwind_frontier.reset();
+  unwind_frontier_steps = 0;
+}
+
+void reachability_treet::keep_unwind_frontier(bool enable)
+{
+  // --schedule shares a single target between all states, and
+  // --smt-during-symex encodes it as it goes: neither can be copied. State
+  // hashing would also need its hit set rolled back.
+  keep_frontier = enable && !schedule && !smt_during_symex && !state_hashing;
+}
+
+void reachability_treet::record_unwind_frontier(
+  const execution_statet &ex_state)
+{
+  if (!keep_frontier || frontier_reached)
+    return;
+
+  frontier_reached = true;
+  unwind_frontier.reset();
+  unwind_frontier_steps = 0;
+
+  // Past a context switch, other interleavings may not share this prefix
+  if (execution_states.size() != 1 || ex_state.threads_state.size() != 1)
+    return;
+
+  auto eq = std::dynamic_pointer_cast<symex_target_equationt>(ex_state.target);
+  if (!eq)
+    return;
+
+  unwind_frontier = ex_state.clone();
+  unwind_frontier_steps = eq->SSA_steps.size();
+  frontier_vars_map = vars_map;
+  frontier_is_global = is_global;
+}
+
+bool reachability_treet::setup_for_resumed_explore()
+{
+  if (!unwind_frontier)
+    return false;
+
+  execution_states.clear();
+  has_complete_formula = false;
+  main_thread_ended = false;
+
+  // Resume with the current bound; everything else is as it was when the
+  // frontier was reached.
+  unwind_frontier->max_unwind = BigInt(options.get_option("unwind").c_str());
+  vars_map = frontier_vars_map;
+  is_global = frontier_is_global;
+
+  execution_states.push_back(std::move(unwind_frontier));
+  cur_state_it = execution_states.begin();
+
+  frontier_reached = false;
+  unwind_frontier_steps = 0;
+  return true;
+}
+
+size_t reachability_treet::get_unwind_frontier_steps() const
+{
+  return unwind_frontier ? unwind_frontier_steps : 0;
 }
 
 execution_statet &reachability_treet::get_cur_state()
@@ -70,9 +70,10 @@ public:
     contextt &context);
 
   /**
-   *  Default destructor.
+   *  Destructor. Releases the execution states with this run's object
+   *  numbering installed, see value_set_numbering.
    */
-  virtual ~reachability_treet() = default;
+  virtual ~reachability_treet();
 
   /** Reinitialize for making new exploration of given functions.
    *  Sets up the flags and fields of the object to start a new exploration of
@@ -232,6 +233,39 @@ public:
    */
   bool setup_next_formula();
 
+  /**
+   *  Incremental symex across unwinding bounds.
+   *  Symex is identical for any --unwind bound up to the first point where
+   *  the bound may cut a loop or a recursion (the unwind frontier). When
+   *  enabled, the execution_statet reaching that point is copied, and the
+   *  next exploration, with a larger bound, resumes from that copy instead
+   *  of starting from the program entry again.
+   *  @param enable Whether to keep a copy of the unwind frontier
+   */
+  void keep_unwind_frontier(bool enable);
+
+  /**
+   *  Record the unwind frontier, called by execution_statet right before it
+   *  executes an instruction whose outcome depends on --unwind. Only the
+   *  first call of an exploration is recorded, and only when no other thread
+   *  has been started yet, so that every interleaving shares the prefix.
+   *  @param ex_state State that reached the frontier
+   */
+  void record_unwind_frontier(const execution_statet &ex_state);
+
+  /**
+   *  Set up a new exploration resuming from the recorded unwind frontier,
+   *  with the current --unwind bound. Like setup_for_new_explore otherwise.
+   *  @return False if there is no frontier to resume from
+   */
+  bool setup_for_resumed_explore();
+
+  /**
+   *  Number of SSA steps that the current exploration shares with the next
+   *  one, if resumed. Zero if no unwind frontier was recorded.
+   */
+  size_t get_unwind_frontier_steps() const;
+
   /**
    *  Class recording a reachability checkpoint.
    *  Currently likely broken; but this originally redorced a particular trace
@@ -301,6 +335,10 @@ public:
    */
   void save_checkpoint(const std::string &&fname) const;
 
+  /** Numbering of the objects pointed at by the value sets of this run.
+   *  Callers install it with value_sett::numbering_scopet around any
+   *  exploration. Declared first, so that it outlives every ex_state. */
+  value_set_numberingt value_set_numbering;
   /** GOTO functions we're operating over. */
   goto_functionst &goto_functions;
   /** Context we're operating upon */
@@ -359,6 +397,18 @@ protected:
   bool schedule;
   /** Are we using the --smt-during-symex method? */
   bool smt_during_symex;
+  /** Whether the unwind frontier is recorded, see keep_unwind_frontier */
+  bool keep_frontier = false;
+  /** Whether the current exploration already reached its unwind frontier */
+  bool frontier_reached = false;
+  /** Copy of the state at the unwind frontier, or null if unusable */
+  std::shared_ptr<execution_statet> unwind_frontier;
+  /** Number of SSA steps preceding the unwind frontier */
+  size_t unwind_frontier_steps = 0;
+  /** Global access tracking at the unwind frontier, restored on resume */
+  std::unordered_map<expr2tc, std::list<unsigned int>, irep2_hash>
+    frontier_vars_map;
+  std::unordered_set<expr2tc, irep2_hash> frontier_is_global;
 
   /* Map to store the expression and thread ID,
    * which that expression belongs to. */
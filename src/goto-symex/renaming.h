@@ -7,6 +7,7 @@
 #include <util/expr_util.h>
 #include <util/guard.h>
 #include <util/i2string.h>
+#include <util/persistent_map.h>
 #include <irep2/irep2_expr.h>
 #include <util/std_expr.h>
 
@@ -276,7 +277,8 @@ public:
 
   friend void build_goto_symex_classes();
   // Repeat of the above ignored friend directive.
-  typedef std::unordered_map<name_record, valuet, name_rec_hash> current_namest;
+  // Shared with the clones made at branch points, see persistent_mapt
+  typedef persistent_mapt<name_record, valuet, name_rec_hash> current_namest;
 
   current_namest current_names;
   typedef std::map<const expr2tc, crypto_hash> current_state_hashest;
@@ -35,20 +35,19 @@ void symex_slicet::run_on_assert(symex_target_equationt::SSA_stept &SSA_step)
   get_symbols<true>(SSA_step.cond);
 }
 
-void symex_slicet::run_on_assume(symex_target_equationt::SSA_stept &SSA_step)
+bool symex_slicet::keep_assume(
+  const symex_target_equationt::SSA_stept &SSA_step)
 {
   if (!slice_assumes)
   {
     get_symbols<true>(SSA_step.guard);
     get_symbols<true>(SSA_step.cond);
-    return;
+    return true;
   }
 
   if (!get_symbols<false>(SSA_step.cond))
   {
     // we don't really need it
-    SSA_step.ignore = true;
-    ++sliced;
     if (is_symbol2t(SSA_step.cond))
       log_debug(
         "slice",
@@ -56,17 +55,26 @@ void symex_slicet::run_on_assume(symex_target_equationt::SSA_stept &SSA_step)
         to_symbol2t(SSA_step.cond).get_symbol_name());
     else
       log_debug("slice", "slice ignoring assume expression");
+    return false;
   }
-  else
+
+  // If we need it, add the symbols to dependency
+  get_symbols<true>(SSA_step.guard);
+  get_symbols<true>(SSA_step.cond);
+  return true;
+}
+
+void symex_slicet::run_on_assume(symex_target_equationt::SSA_stept &SSA_step)
+{
+  if (!keep_assume(SSA_step))
   {
-    // If we need it, add the symbols to dependency
-    get_symbols<true>(SSA_step.guard);
-    get_symbols<true>(SSA_step.cond);
+    SSA_step.ignore = true;
+    ++sliced;
   }
 }
 
-void symex_slicet::run_on_assignment(
-  symex_target_equationt::SSA_stept &SSA_step)
+bool symex_slicet::keep_assignment(
+  const symex_target_equationt::SSA_stept &SSA_step)
 {
   assert(is_symbol2t(SSA_step.lhs));
   // TODO: create an option to ignore nondet symbols (test case generation)
@@ -81,45 +89,110 @@ void symex_slicet::run_on_assignment(
       {
         auto &sym = to_symbol2t(expr);
         if (has_prefix(sym.thename.as_string(), "nondet$"))
-          return;
+          return true;
       }
     }
 
     // we don't really need it
-    SSA_step.ignore = true;
-    ++sliced;
     log_debug(
       "slice",
       "slice ignoring assignment to symbol {}",
       to_symbol2t(SSA_step.lhs).get_symbol_name());
+    return false;
   }
-  else
-  {
-    get_symbols<true>(SSA_step.guard);
-    get_symbols<true>(SSA_step.rhs);
 
-    // Remove this symbol as we won't be seeing any references to it further
-    // into the history.
-    depends.erase(to_symbol2t(SSA_step.lhs).get_symbol_name());
+  get_symbols<true>(SSA_step.guard);
+  get_symbols<true>(SSA_step.rhs);
+
+  // Remove this symbol as we won't be seeing any references to it further
+  // into the history.
+  depends.erase(to_symbol2t(SSA_step.lhs).get_symbol_name());
+  return true;
+}
+
+void symex_slicet::run_on_assignment(
+  symex_target_equationt::SSA_stept &SSA_step)
+{
+  if (!keep_assignment(SSA_step))
+  {
+    SSA_step.ignore = true;
+    ++sliced;
   }
 }
 
-void symex_slicet::run_on_renumber(symex_target_equationt::SSA_stept &SSA_step)
+bool symex_slicet::keep_renumber(
+  const symex_target_equationt::SSA_stept &SSA_step)
 {
   assert(is_symbol2t(SSA_step.lhs));
 
   if (!get_symbols<false>(SSA_step.lhs))
   {
     // we don't really need it
-    SSA_step.ignore = true;
-    ++sliced;
     log_debug(
       "slice",
       "slice ignoring renumbering symbol {}",
       to_symbol2t(SSA_step.lhs).get_symbol_name());
+    return false;
   }
 
   // Don't collect the symbol; this insn has no effect on dependencies.
+  return true;
+}
+
+void symex_slicet::run_on_renumber(symex_target_equationt::SSA_stept &SSA_step)
+{
+  if (!keep_renumber(SSA_step))
+  {
+    SSA_step.ignore = true;
+    ++sliced;
+  }
+}
+
+bool symex_slicet::keep_step(const symex_target_equationt::SSA_stept &SSA_step)
+{
+  switch (SSA_step.type)
+  {
+  case goto_trace_stept::ASSIGNMENT:
+    return keep_assignment(SSA_step);
+  case goto_trace_stept::ASSUME:
+    return keep_assume(SSA_step);
+  case goto_trace_stept::ASSERT:
+    get_symbols<true>(SSA_step.guard);
+    get_symbols<true>(SSA_step.cond);
+    return true;
+  case goto_trace_stept::RENUMBER:
+    return keep_renumber(SSA_step);
+  default:
+    return true;
+  }
+}
+
+bool symex_slicet::run(
+  const symex_target_equationt::SSA_stepst &eq,
+  std::vector<bool> &ignore)
+{
+  assert(ignore.size() == eq.size());
+  sliced = 0;
+  fine_timet algorithm_start = current_time();
+  size_t idx = eq.size();
+  for (const auto &step : boost::adaptors::reverse(eq))
+  {
+    --idx;
+    if (ignore[idx])
+      continue;
+
+    if (!keep_step(step))
+    {
+      ignore[idx] = true;
+      ++sliced;
+    }
+  }
+  fine_timet algorithm_stop = current_time();
+  log_status(
+    "Slicing time: {}s (removed {} assignments)",
+    time2string(algorithm_stop - algorithm_start),
+    sliced);
+  return true;
 }
 
 /**
@@ -159,6 +232,35 @@ bool simple_slice::run(symex_target_equationt::SSA_stepst &steps)
   return true;
 }
 
+void claim_slicer::set_claim_info(const symex_target_equationt::SSA_stept &step)
+{
+  if (!is_goto_cov)
+    // obtain the guard info from the assertions
+    claim_msg = from_expr(ns, "", step.source.pc->guard);
+  else
+    // in goto-coverage mode, the assertions are converted to assert(0）
+    // the original guards are stored in comment.
+    claim_msg = step.comment;
+  claim_loc = step.source.pc->location.as_string();
+  claim_cstr = step.comment + " at " + claim_loc;
+}
+
+void claim_slicer::log_slice_time(fine_timet algorithm_start) const
+{
+  fine_timet algorithm_stop = current_time();
+  if (show_slice_info)
+    log_status(
+      "Slicing for Claim {} ({}s)",
+      claim_msg,
+      time2string(algorithm_stop - algorithm_start));
+  else
+    log_debug(
+      "c++",
+      "Slicing for Claim {} ({}s)",
+      claim_msg,
+      time2string(algorithm_stop - algorithm_start));
+}
+
 bool claim_slicer::run(symex_target_equationt::SSA_stepst &steps)
 {
   sliced = 0;
@@ -176,15 +278,7 @@ bool claim_slicer::run(symex_target_equationt::SSA_stepst &steps)
         claim_to_keep) // this is the assertion that we should not skip!
       {
         it->ignore = false;
-        if (!is_goto_cov)
-          // obtain the guard info from the assertions
-          claim_msg = from_expr(ns, "", it->source.pc->guard);
-        else
-          // in goto-coverage mode, the assertions are converted to assert(0）
-          // the original guards are stored in comment.
-          claim_msg = it->comment;
-        claim_loc = it->source.pc->location.as_string();
-        claim_cstr = it->comment + " at " + claim_loc;
+        set_claim_info(*it);
         continue;
       }
 
@@ -193,21 +287,42 @@ bool claim_slicer::run(symex_target_equationt::SSA_stepst &steps)
     }
   }
 
-  fine_timet algorithm_stop = current_time();
-  if (show_slice_info)
-    log_status(
-      "Slicing for Claim {} ({}s)",
-      claim_msg,
-      time2string(algorithm_stop - algorithm_start));
-  else
-    log_debug(
-      "c++",
-      "Slicing for Claim {} ({}s)",
-      claim_msg,
-      time2string(algorithm_stop - algorithm_start));
+  log_slice_time(algorithm_start);
+  return true;
+}
 
+bool claim_slicer::run(
+  const symex_target_equationt::SSA_stepst &steps,
+  std::vector<bool> &ignore)
+{
+  sliced = 0;
+  fine_timet algorithm_start = current_time();
+  ignore.resize(steps.size());
+  size_t counter = 1;
+  size_t idx = 0;
+  for (const auto &step : steps)
+  {
+    ignore[idx] = step.ignore;
+    if (step.is_assert())
+    {
+      if (counter++ == claim_to_keep)
+      {
+        ignore[idx] = false;
+        set_claim_info(step);
+      }
+      else
+      {
+        ignore[idx] = true;
+        ++sliced;
+      }
+    }
+    ++idx;
+  }
+
+  log_slice_time(algorithm_start);
   return true;
 }
+
 // Recursively try to extract the nondet symbol of an expression
 expr2tc symex_slicet::get_nondet_symbol(const expr2tc &expr)
 {
@@ -61,6 +61,16 @@ public:
     }
   };
   bool run(symex_target_equationt::SSA_stepst &) override;
+
+  /**
+   * Same as run(), but leaves \steps untouched and records the result in
+   * \ignore instead, one entry per step. Steps that are already ignored in
+   * \steps start out ignored.
+   */
+  bool run(
+    const symex_target_equationt::SSA_stepst &steps,
+    std::vector<bool> &ignore);
+
   size_t claim_to_keep;
   std::string claim_msg;
   std::string claim_loc;
@@ -68,6 +78,10 @@ public:
   bool show_slice_info;
   bool is_goto_cov;
   namespacet ns;
+
+protected:
+  void set_claim_info(const symex_target_equationt::SSA_stept &step);
+  void log_slice_time(fine_timet start) const;
 };
 
 /**
@@ -114,6 +128,18 @@ public:
     return true;
   }
 
+  /**
+   * Same as run(), but leaves \eq untouched and records the sliced steps in
+   * \ignore instead, one entry per step. This lets several claims be sliced
+   * concurrently out of a single shared equation.
+   *
+   * @param eq symex formula to be sliced
+   * @param ignore steps to skip on input, steps to skip after slicing on output
+   */
+  bool run(
+    const symex_target_equationt::SSA_stepst &eq,
+    std::vector<bool> &ignore);
+
   /**
    * Holds the symbols the current equation depends on.
    */
@@ -225,6 +251,15 @@ protected:
    * @param SSA_step an renumber step
    */
   void run_on_renumber(symex_target_equationt::SSA_stept &SSA_step) override;
+
+  /**
+   * Slicing decisions shared by both run() variants: each returns whether
+   * \SSA_step has to be kept, updating #depends accordingly.
+   */
+  bool keep_step(const symex_target_equationt::SSA_stept &SSA_step);
+  bool keep_assume(const symex_target_equationt::SSA_stept &SSA_step);
+  bool keep_assignment(const symex_target_equationt::SSA_stept &SSA_step);
+  bool keep_renumber(const symex_target_equationt::SSA_stept &SSA_step);
 };
 
 #endif
@@ -92,6 +92,7 @@ goto_symext &goto_symext::operator=(const goto_symext &sym)
   constant_propagation = sym.constant_propagation;
   total_claims = sym.total_claims;
   remaining_claims = sym.remaining_claims;
+  merge_stats = sym.merge_stats;
   guard_identifier_s = sym.guard_identifier_s;
   depth_limit = sym.depth_limit;
   break_insn = sym.break_insn;
@@ -334,7 +334,21 @@ void goto_symext::phi_function(const statet::goto_statet &goto_state)
     tmp_guard -= cur_state->guard;
   }
 
-  for (const auto &[variable, _] : variables)
+  // Only variables renamed on either branch since the states were forked can
+  // differ. Their entries lie in the parts of the level2 table not shared
+  // with the goto state, which keeps the merge proportional to the branch
+  // rather than to the whole program state. Collect them before assigning,
+  // as the assignments below update the table.
+  std::vector<renaming::level2t::name_record> changed;
+  variables.for_each_unshared(goto_variables, [&changed](const auto &entry) {
+    changed.push_back(entry.first);
+  });
+
+  ++merge_stats.joins;
+  merge_stats.phi_visited += changed.size();
+  merge_stats.phi_total += variables.size();
+
+  for (const auto &variable : changed)
   {
     if (
       goto_state.level2.current_number(variable) ==
@@ -391,6 +405,7 @@ void goto_symext::phi_function(const statet::goto_statet &goto_state)
     cur_state->rename_type(new_lhs);
     cur_state->rename_type(rhs);
     cur_state->assignment(new_lhs, rhs);
+    ++merge_stats.phi_assignments;
 
     target->assignment(
       gen_true_expr(),
@@ -457,3 +472,45 @@ bool goto_symext::get_unwind(
 
   return stop_unwind;
 }
+
+bool goto_symext::at_unwind_frontier() const
+{
+  if (max_unwind == 0)
+    return false;
+
+  const goto_programt::instructiont &instruction = *cur_state->source.pc;
+
+  if (instruction.is_backwards_goto())
+  {
+    // Self-loops are cut regardless of the bound
+    if (instruction.targets.front() == cur_state->source.pc)
+      return false;
+
+    unsigned id = instruction.loop_number;
+    if (unwind_set.count(id) != 0)
+      return false;
+
+    auto it = cur_state->loop_iterations.find(id);
+    BigInt unwind = it == cur_state->loop_iterations.end() ? 0 : it->second;
+    return unwind + 1 >= max_unwind;
+  }
+
+  if (instruction.is_function_call())
+  {
+    const code_function_call2t &call =
+      to_code_function_call2t(instruction.code);
+    if (is_symbol2t(call.function))
+    {
+      auto it =
+        cur_state->function_unwind.find(to_symbol2t(call.function).thename);
+      return it != cur_state->function_unwind.end() && it->second >= max_unwind;
+    }
+
+    // We can't tell which function a pointer calls yet, be conservative
+    for (const auto &[_, unwind] : cur_state->function_unwind)
+      if (unwind >= max_unwind)
+        return true;
+  }
+
+  return false;
+}
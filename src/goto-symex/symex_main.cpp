@@ -168,7 +168,9 @@ void goto_symext::assume(const expr2tc &the_assumption)
 
 goto_symext::symex_resultt goto_symext::get_symex_result()
 {
-  return goto_symext::symex_resultt(target, total_claims, remaining_claims);
+  goto_symext::symex_resultt result(target, total_claims, remaining_claims);
+  result.merge_stats = merge_stats;
+  return result;
 }
 
 void goto_symext::symex_step(reachability_treet &art)
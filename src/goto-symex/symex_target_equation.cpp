@@ -1,3 +1,4 @@
+#include <atomic>
 #include <cassert>
 #include <goto-symex/goto_symex.h>
 #include <goto-symex/goto_symex_state.h>
@@ -6,6 +7,7 @@
 #include <util/expr_util.h>
 #include <util/i2string.h>
 #include <irep2/irep2.h>
+#include <irep2/irep2_hashcons.h>
 #include <util/migrate.h>
 #include <util/std_expr.h>
 
@@ -32,13 +34,14 @@ void symex_target_equationt::assignment(
   SSA_steps.emplace_back();
   SSA_stept &SSA_step = SSA_steps.back();
 
-  SSA_step.guard = guard;
-  SSA_step.lhs = lhs;
+  SSA_step.guard = irep_hashconst::maybe_intern(guard);
+  SSA_step.lhs = irep_hashconst::maybe_intern(lhs);
   SSA_step.original_lhs = original_lhs;
   SSA_step.original_rhs = original_rhs;
-  SSA_step.rhs = rhs;
+  SSA_step.rhs = irep_hashconst::maybe_intern(rhs);
   SSA_step.hidden = hidden;
-  SSA_step.cond = equality2tc(lhs, rhs);
+  SSA_step.cond =
+    irep_hashconst::maybe_intern(equality2tc(SSA_step.lhs, SSA_step.rhs));
   SSA_step.type = goto_trace_stept::ASSIGNMENT;
   SSA_step.source = source;
   SSA_step.stack_trace = stack_trace;
@@ -76,8 +79,8 @@ void symex_target_equationt::assumption(
   SSA_steps.emplace_back();
   SSA_stept &SSA_step = SSA_steps.back();
 
-  SSA_step.guard = guard;
-  SSA_step.cond = cond;
+  SSA_step.guard = irep_hashconst::maybe_intern(guard);
+  SSA_step.cond = irep_hashconst::maybe_intern(cond);
   SSA_step.type = goto_trace_stept::ASSUME;
   SSA_step.source = source;
   SSA_step.loop_number = loop_number;
@@ -97,8 +100,8 @@ void symex_target_equationt::assertion(
   SSA_steps.emplace_back();
   SSA_stept &SSA_step = SSA_steps.back();
 
-  SSA_step.guard = guard;
-  SSA_step.cond = cond;
+  SSA_step.guard = irep_hashconst::maybe_intern(guard);
+  SSA_step.cond = irep_hashconst::maybe_intern(cond);
   SSA_step.type = goto_trace_stept::ASSERT;
   SSA_step.source = source;
   SSA_step.comment = msg;
@@ -142,13 +145,23 @@ void symex_target_equationt::convert(smt_convt &smt_conv)
     smt_conv.assert_ast(smt_conv.make_n_ary_or(assertions));
 }
 
+void symex_target_equationt::convert_without_claims(smt_convt &smt_conv)
+{
+  smt_convt::ast_vec assertions;
+  smt_astt assumpt_ast = smt_conv.convert_ast(gen_true_expr());
+
+  for (auto &SSA_step : SSA_steps)
+    convert_internal_step(smt_conv, assumpt_ast, assertions, SSA_step);
+}
+
 void symex_target_equationt::convert_internal_step(
   smt_convt &smt_conv,
   smt_astt &assumpt_ast,
   smt_convt::ast_vec &assertions,
   SSA_stept &step)
 {
-  static unsigned output_count = 0; // Temporary hack; should become scoped.
+  // Temporary hack; should become scoped.
+  static std::atomic<unsigned> output_count = 0;
   smt_astt true_val = smt_conv.convert_ast(gen_true_expr());
   smt_astt false_val = smt_conv.convert_ast(gen_false_expr());
 
@@ -380,6 +393,28 @@ unsigned int symex_target_equationt::clear_assertions()
   return num_asserts;
 }
 
+symex_target_equationt
+symex_target_equationt::project(const std::vector<bool> &ignore) const
+{
+  assert(ignore.size() == SSA_steps.size());
+  symex_target_equationt result(ns);
+  result.debug_print = debug_print;
+  result.ssa_trace = ssa_trace;
+  result.ssa_smt_trace = ssa_smt_trace;
+
+  size_t idx = 0;
+  for (const auto &SSA_step : SSA_steps)
+  {
+    if (!ignore[idx++])
+    {
+      result.SSA_steps.push_back(SSA_step);
+      result.SSA_steps.back().ignore = false;
+    }
+  }
+
+  return result;
+}
+
 // To be used by reconstruct_symbolic_expression
 void symex_target_equationt::replace_rec(
   const SSA_stept &step,
@@ -541,11 +576,11 @@ tvt runtime_encoded_equationt::ask_solver_question(const expr2tc &question)
   // results are true, false, both.
   push_ctx();
   conv.assert_ast(q);
-  smt_convt::resultt res1 = conv.dec_solve();
+  smt_convt::resultt res1 = conv.dec_solve_refined();
   pop_ctx();
   push_ctx();
   conv.assert_ast(conv.invert_ast(q));
-  smt_convt::resultt res2 = conv.dec_solve();
+  smt_convt::resultt res2 = conv.dec_solve_refined();
   pop_ctx();
 
   // So; which result?
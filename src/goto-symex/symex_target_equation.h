@@ -72,6 +72,14 @@ public:
     const sourcet &source) override;
 
   virtual void convert(smt_convt &smt_conv);
+
+  /**
+   * Encodes the equation like convert(), but without asserting its claims.
+   * The condition of each assertion is left in its step's cond_ast, so that
+   * claims can be checked one at a time on top of this single encoding.
+   */
+  void convert_without_claims(smt_convt &smt_conv);
+
   void convert_internal_step(
     smt_convt &smt_conv,
     smt_astt &assumpt_ast,
@@ -192,6 +200,14 @@ public:
 
   unsigned int clear_assertions();
 
+  /**
+   * Builds an equation holding only the steps not marked in \ignore (one
+   * entry per step). This equation is left untouched, so that several
+   * claims can be projected out of it concurrently, and only the surviving
+   * steps are copied.
+   */
+  symex_target_equationt project(const std::vector<bool> &ignore) const;
+
   std::shared_ptr<symex_targett> clone() const override
   {
     // No pointers or anything that requires ownership modification, can just
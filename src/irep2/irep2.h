@@ -27,7 +27,9 @@
 #include <boost/preprocessor/list/for_each.hpp>
 #include <cstdarg>
 #include <functional>
+#include <atomic>
 #include <mutex>
+#include <irep2/irep2_arena.h>
 #include <util/compiler_defs.h>
 #include <util/crypto_hash.h>
 #include <util/dstring.h>
@@ -318,11 +320,9 @@ public:
   size_t crc() const
   {
     const T *foo = get();
-    {
-      std::lock_guard<std::mutex> lock(foo->crc_mutex);
-      if (foo->crc_val != 0)
-        return foo->crc_val;
-    }
+    size_t crc = foo->crc_val.load(std::memory_order_relaxed);
+    if (crc != 0)
+      return crc;
 
     return foo->do_crc();
   }
@@ -608,8 +608,9 @@ public:
   // XXX XXX XXX this should be const
   type_ids type_id;
 
-  mutable size_t crc_val;
-  mutable std::mutex crc_mutex;
+  /** Cached crc(), 0 if not computed yet. Written at most once per value
+   *  of the fields, so a relaxed atomic is enough to share it. */
+  mutable std::atomic<size_t> crc_val;
 };
 
 /** Fetch identifying name for a type.
@@ -864,8 +865,9 @@ public:
   /** Type of this expr. All exprs have a type. */
   type2tc type;
 
-  mutable size_t crc_val;
-  mutable std::mutex crc_mutex;
+  /** Cached crc(), 0 if not computed yet. Written at most once per value
+   *  of the fields, so a relaxed atomic is enough to share it. */
+  mutable std::atomic<size_t> crc_val;
 };
 
 inline bool is_nil_expr(const expr2tc &exp)
@@ -1177,7 +1179,7 @@ protected:
     unsigned int indent) const;
   bool cmp_rec(const base2t &ref) const;
   int lt_rec(const base2t &ref) const;
-  void do_crc_rec() const;
+  void do_crc_rec(size_t &seed) const;
   void hash_rec(crypto_hash &hash) const;
 
   // These methods are specific to expressions rather than types, and are
@@ -1246,8 +1248,9 @@ protected:
     return 0;
   }
 
-  void do_crc_rec() const
+  void do_crc_rec(size_t &seed) const
   {
+    (void)seed;
   }
 
   void hash_rec(crypto_hash &hash) const
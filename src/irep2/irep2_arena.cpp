@@ -0,0 +1,36 @@
+#include <irep2/irep2_arena.h>
+#include <algorithm>
+
+thread_local irep_arenat *irep_arenat::current_arena = nullptr;
+std::atomic<size_t> irep_arenat::n_live{0};
+
+void *irep_arenat::allocate(size_t bytes)
+{
+  bytes = (bytes + alignment - 1) & ~(alignment - 1);
+
+  if (static_cast<size_t>(end - cur) < bytes)
+  {
+    size_t size = std::max(chunk_size, bytes);
+    chunks.emplace_back(new char[size]);
+    cur = chunks.back().get();
+    end = cur + size;
+  }
+
+  void *p = cur;
+  cur += bytes;
+  total += bytes;
+  refs.fetch_add(1, std::memory_order_relaxed);
+  return p;
+}
+
+irep_arena_scopet::irep_arena_scopet()
+  : arena(new irep_arenat), previous(irep_arenat::current_arena)
+{
+  irep_arenat::current_arena = arena;
+}
+
+irep_arena_scopet::~irep_arena_scopet()
+{
+  irep_arenat::current_arena = previous;
+  arena->release();
+}
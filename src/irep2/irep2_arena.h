@@ -0,0 +1,157 @@
+#ifndef IREP2_ARENA_H_
+#define IREP2_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+/** Bump allocator for irep2 nodes.
+ *  While an irep_arena_scopet is alive, every expr2t/type2t node created by
+ *  that thread is carved out of large chunks owned by its arena instead of
+ *  being allocated individually. Freeing a node only decrements the arena's
+ *  count of live nodes; the chunks are released all at once when the scope
+ *  has ended and the last node allocated in it has been destroyed. Nodes that
+ *  escape the scope (e.g. into a counterexample) therefore stay valid, they
+ *  just keep the arena around.
+ *
+ *  The memory of a freed node is never reused. An arena only pays off for
+ *  nodes that die together, and a single escaping node keeps all of its
+ *  chunks alive. This includes nodes cached in statics the first time they
+ *  are needed, e.g. the types of get_uint_type(), and nodes of one arena
+ *  that are referenced by nodes of another. With --symex-arena, the arena of
+ *  a BMC run is held by the symex state and the equation of that run, so it
+ *  is only released when the next run starts over or bmct is destroyed.
+ */
+class irep_arenat
+{
+public:
+  /** Arena of the innermost scope of this thread, nullptr if none */
+  static irep_arenat *current()
+  {
+    return current_arena;
+  }
+
+  void *allocate(size_t bytes);
+
+  void deallocate(void *p, size_t bytes) noexcept
+  {
+    (void)p;
+    (void)bytes;
+    release();
+  }
+
+  size_t allocated_bytes() const
+  {
+    return total;
+  }
+
+  /** Number of arenas whose chunks have not been released yet */
+  static size_t live_arenas()
+  {
+    return n_live;
+  }
+
+protected:
+  friend class irep_arena_scopet;
+
+  irep_arenat()
+  {
+    ++n_live;
+  }
+
+  ~irep_arenat()
+  {
+    --n_live;
+  }
+
+  void release() noexcept
+  {
+    if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      delete this;
+  }
+
+  static constexpr size_t chunk_size = 1 << 20;
+  static constexpr size_t alignment = alignof(std::max_align_t);
+
+  std::vector<std::unique_ptr<char[]>> chunks;
+  char *cur = nullptr;
+  char *end = nullptr;
+  size_t total = 0;
+  /** Live nodes, plus one while the scope is open */
+  std::atomic<size_t> refs{1};
+
+  static thread_local irep_arenat *current_arena;
+  static std::atomic<size_t> n_live;
+};
+
+/** Makes a fresh arena current for this thread for its lifetime */
+class irep_arena_scopet
+{
+public:
+  irep_arena_scopet();
+  ~irep_arena_scopet();
+
+  irep_arena_scopet(const irep_arena_scopet &) = delete;
+  irep_arena_scopet &operator=(const irep_arena_scopet &) = delete;
+
+  size_t allocated_bytes() const
+  {
+    return arena->allocated_bytes();
+  }
+
+protected:
+  irep_arenat *arena;
+  irep_arenat *previous;
+};
+
+/** Allocator for std::allocate_shared, which takes memory from the arena
+ *  that was current when the node was created, or from the heap */
+template <typename T>
+class irep_allocatort
+{
+public:
+  typedef T value_type;
+
+  irep_allocatort() noexcept : arena(irep_arenat::current())
+  {
+  }
+
+  template <typename U>
+  irep_allocatort(const irep_allocatort<U> &other) noexcept
+    : arena(other.arena)
+  {
+  }
+
+  T *allocate(size_t n)
+  {
+    if (arena)
+      return static_cast<T *>(arena->allocate(n * sizeof(T)));
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *p, size_t n) noexcept
+  {
+    if (arena)
+      arena->deallocate(p, n * sizeof(T));
+    else
+      ::operator delete(p);
+  }
+
+  template <typename U>
+  bool operator==(const irep_allocatort<U> &other) const noexcept
+  {
+    return arena == other.arena;
+  }
+
+  template <typename U>
+  bool operator!=(const irep_allocatort<U> &other) const noexcept
+  {
+    return arena != other.arena;
+  }
+
+  irep_arenat *arena;
+};
+
+#endif
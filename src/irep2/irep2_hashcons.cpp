@@ -0,0 +1,155 @@
+#include <irep2/irep2_hashcons.h>
+#include <array>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+// Independent buckets, so that threads interning different nodes rarely
+// wait on each other
+constexpr size_t n_shards = 64;
+
+template <typename T, typename Hash>
+struct shardt
+{
+  std::mutex mutex;
+  std::unordered_set<T, Hash> nodes;
+};
+
+template <typename T, typename Hash>
+using shardst = std::array<shardt<T, Hash>, n_shards>;
+
+template <typename T, typename Hash>
+T find(shardst<T, Hash> &shards, const T &node)
+{
+  shardt<T, Hash> &shard = shards[node.crc() % n_shards];
+  std::lock_guard lock(shard.mutex);
+  auto it = shard.nodes.find(node);
+  return it == shard.nodes.end() ? T() : *it;
+}
+
+template <typename T, typename Hash>
+T insert(shardst<T, Hash> &shards, const T &node)
+{
+  shardt<T, Hash> &shard = shards[node.crc() % n_shards];
+  std::lock_guard lock(shard.mutex);
+  return *shard.nodes.insert(node).first;
+}
+
+template <typename T, typename Hash>
+void clear(shardst<T, Hash> &shards)
+{
+  for (auto &shard : shards)
+  {
+    std::lock_guard lock(shard.mutex);
+    shard.nodes.clear();
+  }
+}
+
+template <typename T, typename Hash>
+size_t size(shardst<T, Hash> &shards)
+{
+  size_t n = 0;
+  for (auto &shard : shards)
+  {
+    std::lock_guard lock(shard.mutex);
+    n += shard.nodes.size();
+  }
+  return n;
+}
+} // namespace
+
+struct irep_hashconst::tablet
+{
+  shardst<expr2tc, irep2_hash> exprs;
+  shardst<type2tc, type2_hash> types;
+};
+
+thread_local irep_hashconst *irep_hashconst::current_table = nullptr;
+
+irep_hashconst::irep_hashconst() : table(new tablet)
+{
+}
+
+irep_hashconst::~irep_hashconst() = default;
+
+type2tc irep_hashconst::intern(const type2tc &type)
+{
+  if (is_nil_type(type))
+    return type;
+
+  // Already interned (or equal to something that is): its subtypes are too
+  if (type2tc hit = find(table->types, type))
+    return hit;
+
+  std::vector<type2tc> subtypes;
+  bool changed = false;
+  type->foreach_subtype([this, &subtypes, &changed](const type2tc &t) {
+    subtypes.push_back(intern(t));
+    changed |= subtypes.back().get() != t.get();
+  });
+
+  type2tc result = type;
+  if (changed)
+  {
+    size_t i = 0;
+    result->Foreach_subtype([&subtypes, &i](type2tc &t) { t = subtypes[i++]; });
+  }
+
+  return insert(table->types, result);
+}
+
+expr2tc irep_hashconst::intern(const expr2tc &expr)
+{
+  if (is_nil_expr(expr))
+    return expr;
+
+  // Already interned (or equal to something that is): its operands are too
+  if (expr2tc hit = find(table->exprs, expr))
+    return hit;
+
+  std::vector<expr2tc> operands;
+  bool changed = false;
+  expr->foreach_operand([this, &operands, &changed](const expr2tc &op) {
+    operands.push_back(intern(op));
+    changed |= operands.back().get() != op.get();
+  });
+
+  type2tc type = intern(expr->type);
+  changed |= type.get() != expr->type.get();
+
+  expr2tc result = expr;
+  if (changed)
+  {
+    // Detaches from `expr`, which the caller may still share
+    expr2t *e = result.get();
+    e->type = type;
+    size_t i = 0;
+    e->Foreach_operand([&operands, &i](expr2tc &op) { op = operands[i++]; });
+  }
+
+  return insert(table->exprs, result);
+}
+
+void irep_hashconst::clear()
+{
+  ::clear(table->exprs);
+  ::clear(table->types);
+}
+
+size_t irep_hashconst::size()
+{
+  return ::size(table->exprs) + ::size(table->types);
+}
+
+irep_hashcons_scopet::irep_hashcons_scopet()
+  : previous(irep_hashconst::current_table)
+{
+  irep_hashconst::current_table = &table;
+}
+
+irep_hashcons_scopet::~irep_hashcons_scopet()
+{
+  irep_hashconst::current_table = previous;
+}
@@ -0,0 +1,74 @@
+#ifndef IREP2_HASHCONS_H_
+#define IREP2_HASHCONS_H_
+
+#include <irep2/irep2.h>
+#include <memory>
+
+/** Hash-consing of irep2 nodes.
+ *  intern() maps a node to the canonical instance of everything structurally
+ *  equal to it, after interning its operands and types. Equal trees thus end
+ *  up as the same pointer, which irep_container's comparison operators check
+ *  first, and duplicate subtrees of large equations share their memory. The
+ *  crc of an interned node is computed once, when it is interned.
+ *
+ *  The table holds a reference to every node in it, so their use count never
+ *  drops to one and irep_container's copy-on-write clones them rather than
+ *  modifying them in place: interned nodes are immutable. Clearing or
+ *  destroying the table only drops these references, every node handed out
+ *  stays valid.
+ *
+ *  Each run owns its table and makes it current for its thread with
+ *  irep_hashcons_scopet, so that concurrent runs don't share one. A table is
+ *  still safe to use from several threads.
+ */
+class irep_hashconst
+{
+public:
+  irep_hashconst();
+  ~irep_hashconst();
+
+  irep_hashconst(const irep_hashconst &) = delete;
+  irep_hashconst &operator=(const irep_hashconst &) = delete;
+
+  expr2tc intern(const expr2tc &expr);
+  type2tc intern(const type2tc &type);
+
+  void clear();
+  size_t size();
+
+  /** Interns `expr` into the current table of this thread, if there is one,
+   *  otherwise returns it */
+  static expr2tc maybe_intern(const expr2tc &expr)
+  {
+    return current_table ? current_table->intern(expr) : expr;
+  }
+
+protected:
+  struct tablet;
+  std::unique_ptr<tablet> table;
+
+  friend class irep_hashcons_scopet;
+  static thread_local irep_hashconst *current_table;
+};
+
+/** Makes a fresh table current for this thread for its lifetime */
+class irep_hashcons_scopet
+{
+public:
+  irep_hashcons_scopet();
+  ~irep_hashcons_scopet();
+
+  irep_hashcons_scopet(const irep_hashcons_scopet &) = delete;
+  irep_hashcons_scopet &operator=(const irep_hashcons_scopet &) = delete;
+
+  irep_hashconst &get()
+  {
+    return table;
+  }
+
+protected:
+  irep_hashconst table;
+  irep_hashconst *previous;
+};
+
+#endif
@@ -117,13 +117,14 @@ auto esbmct::irep_methods2<derived, baseclass, traits, enable, fields>::clone()
   const -> base_container2tc
 {
   const derived *derived_this = static_cast<const derived *>(this);
-  // Use std::make_shared to clone this with one allocation, it puts the ref
-  // counting block ahead of the data object itself. This necessitates making
-  // a bare std::shared_ptr first, and then feeding that into an expr2tc
-  // container.
+  // Use std::allocate_shared to clone this with one allocation, it puts the
+  // ref counting block ahead of the data object itself (in the current
+  // irep_arenat, if any). This necessitates making a bare std::shared_ptr
+  // first, and then feeding that into an expr2tc container.
   // Generally, storing an irep in a bare std::shared_ptr loses the detach
   // facility and breaks everything, this is an exception.
-  return base_container2tc(std::make_shared<derived>(*derived_this));
+  return base_container2tc(
+    std::allocate_shared<derived>(irep_allocatort<derived>(), *derived_this));
 }
 
 template <
@@ -176,18 +177,17 @@ size_t
 esbmct::irep_methods2<derived, baseclass, traits, enable, fields>::do_crc()
   const
 {
-  std::lock_guard<std::mutex> lock(this->crc_mutex);
-  if (this->crc_val != 0)
-    return this->crc_val;
+  size_t crc = this->crc_val.load(std::memory_order_relaxed);
+  if (crc != 0)
+    return crc;
 
   // Starting from 0, pass a crc value through all the sub-fields of this
-  // expression. Store it into crc_val.
-  assert(this->crc_val == 0);
+  // expression. Two threads may race to compute it, but they both store the
+  // same value.
+  do_crc_rec(crc); // _includes_ type_id / expr_id
 
-  do_crc_rec(); // _includes_ type_id / expr_id
-
-  // Finally, combine the crc of this expr with the input , and return
-  return this->crc_val;
+  this->crc_val.store(crc, std::memory_order_relaxed);
+  return crc;
 }
 
 template <
@@ -283,15 +283,15 @@ template <
   typename enable,
   typename fields>
 void esbmct::irep_methods2<derived, baseclass, traits, enable, fields>::
-  do_crc_rec() const
+  do_crc_rec(size_t &seed) const
 {
   const derived *derived_this = static_cast<const derived *>(this);
   auto m_ptr = membr_ptr::value;
 
   size_t tmp = do_type_crc(derived_this->*m_ptr);
-  boost::hash_combine(this->crc_val, tmp);
+  boost::hash_combine(seed, tmp);
 
-  superclass::do_crc_rec();
+  superclass::do_crc_rec(seed);
 }
 
 template <
@@ -50,8 +50,8 @@ type2t::type2t(type_ids id) : type_id(id), crc_val(0)
 {
 }
 
-type2t::type2t(const type2t &ref) : type_id(ref.type_id), crc_val(ref.crc_val)
-// NOTE: crc_mutex not mentioned here so fresh mutex is created.
+type2t::type2t(const type2t &ref)
+  : type_id(ref.type_id), crc_val(ref.crc_val.load())
 {
 }
 
@@ -119,8 +119,10 @@ size_t type2t::crc() const
 
 size_t type2t::do_crc() const
 {
-  boost::hash_combine(this->crc_val, (uint8_t)type_id);
-  return this->crc_val;
+  size_t crc = crc_val.load(std::memory_order_relaxed);
+  boost::hash_combine(crc, (uint8_t)type_id);
+  crc_val.store(crc, std::memory_order_relaxed);
+  return crc;
 }
 
 void type2t::hash(crypto_hash &hash) const
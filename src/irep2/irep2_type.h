@@ -297,8 +297,10 @@ public:
   template <typename... Args>                                                  \
   inline type2tc basename##_type2tc(Args &&...args)                            \
   {                                                                            \
+    irep_allocatort<basename##_type2t> alloc;                                  \
     return type2tc(std::static_pointer_cast<type2t>(                           \
-      std::make_shared<basename##_type2t>(std::forward<Args>(args)...)));      \
+      std::allocate_shared<basename##_type2t>(                                 \
+        alloc, std::forward<Args>(args)...)));                                 \
   }                                                                            \
   typedef esbmct::                                                             \
     type_methods2<basename##_type2t, superclass, superclass::traits>           \
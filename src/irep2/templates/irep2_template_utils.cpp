@@ -563,6 +563,9 @@ size_t do_type_crc(const std::vector<expr2tc> &theval)
 
 void do_type_hash(const std::vector<expr2tc> &theval, crypto_hash &hash)
 {
+  // Lengths are hashed too, so that neighbouring fields can't blend
+  size_t size = theval.size();
+  hash.ingest(&size, sizeof(size));
   for (auto const &it : theval)
     it->hash(hash);
 }
@@ -578,6 +581,8 @@ size_t do_type_crc(const std::vector<type2tc> &theval)
 
 void do_type_hash(const std::vector<type2tc> &theval, crypto_hash &hash)
 {
+  size_t size = theval.size();
+  hash.ingest(&size, sizeof(size));
   for (auto const &it : theval)
     it->hash(hash);
 }
@@ -593,8 +598,10 @@ size_t do_type_crc(const std::vector<irep_idt> &theval)
 
 void do_type_hash(const std::vector<irep_idt> &theval, crypto_hash &hash)
 {
+  size_t size = theval.size();
+  hash.ingest(&size, sizeof(size));
   for (auto const &it : theval)
-    hash.ingest((void *)it.as_string().c_str(), it.as_string().size());
+    do_type_hash(it, hash);
 }
 
 size_t do_type_crc(const expr2tc &theval)
@@ -608,6 +615,11 @@ void do_type_hash(const expr2tc &theval, crypto_hash &hash)
 {
   if (theval.get() != nullptr)
     theval->hash(hash);
+  else
+  {
+    uint8_t nil = 0xff;
+    hash.ingest(&nil, sizeof(nil));
+  }
 }
 
 size_t do_type_crc(const type2tc &theval)
@@ -621,6 +633,11 @@ void do_type_hash(const type2tc &theval, crypto_hash &hash)
 {
   if (theval.get() != nullptr)
     theval->hash(hash);
+  else
+  {
+    uint8_t nil = 0xff;
+    hash.ingest(&nil, sizeof(nil));
+  }
 }
 
 size_t do_type_crc(const irep_idt &theval)
@@ -630,7 +647,10 @@ size_t do_type_crc(const irep_idt &theval)
 
 void do_type_hash(const irep_idt &theval, crypto_hash &hash)
 {
-  hash.ingest((void *)theval.as_string().c_str(), theval.as_string().size());
+  const std::string &str = theval.as_string();
+  size_t size = str.size();
+  hash.ingest(&size, sizeof(size));
+  hash.ingest((void *)str.c_str(), size);
 }
 
 size_t do_type_crc(const type2t::type_ids &i)
@@ -32,22 +32,62 @@ language_uit &language_uit::operator=(language_uit &&o) noexcept
 
 bool language_uit::parse(const cmdlinet &cmdline)
 {
-  for (const auto &arg : cmdline.args)
+  const std::string parse_jobs = config.options.get_option("parse-jobs");
+  // Checked to be a non-negative number with the command line
+  const long jobs =
+    !parse_jobs.empty() ? strtol(parse_jobs.c_str(), nullptr, 10) : 1;
+  assert(jobs >= 0);
+
+  if (jobs == 1)
+  {
+    for (const auto &arg : cmdline.args)
+    {
+      if (parse(arg))
+        return true;
+    }
+
+    return false;
+  }
+
+  // Hand consecutive files of the same language over at once, so that they
+  // can be parsed concurrently
+  const cmdlinet::argst &args = cmdline.args;
+  for (size_t i = 0; i < args.size();)
   {
-    if (parse(arg))
+    languaget *language = nullptr;
+    std::vector<std::string> files;
+    for (; i < args.size(); i++)
+    {
+      if (language && language_id_by_path(args[i]) != config.language.lid)
+        break;
+
+      language = get_language(args[i]);
+      if (!language)
+        return true;
+
+      files.push_back(args[i]);
+    }
+
+    for (const std::string &file : files)
+      log_progress("Parsing {}", file);
+
+    if (language->parse_files(files, jobs))
+    {
+      log_error("PARSING ERROR");
       return true;
+    }
   }
 
   return false;
 }
 
-bool language_uit::parse(const std::string &filename)
+languaget *language_uit::get_language(const std::string &filename)
 {
   language_idt lang = language_id_by_path(filename);
   if (lang == language_idt::NONE)
   {
     log_error("failed to figure out type of file {}", filename);
-    return true;
+    return nullptr;
   }
 
   config.language.lid = lang;
@@ -57,11 +97,9 @@ bool language_uit::parse(const std::string &filename)
   if (!infile)
   {
     log_error("failed to open input file {}", filename);
-    return true;
+    return nullptr;
   }
 
-  log_progress("Parsing {}", filename);
-
   auto it = langmap.find(lang);
   if (it == langmap.end())
   {
@@ -76,10 +114,21 @@ bool language_uit::parse(const std::string &filename)
       "{}frontend for {} was not built on this version of ESBMC",
       config.options.get_bool_option("old-frontend") ? "old-" : "",
       language_name(lang));
-    return true;
+    return nullptr;
   }
 
-  if (it->second->parse(filename))
+  return it->second.get();
+}
+
+bool language_uit::parse(const std::string &filename)
+{
+  languaget *language = get_language(filename);
+  if (!language)
+    return true;
+
+  log_progress("Parsing {}", filename);
+
+  if (language->parse(filename))
   {
     log_error("PARSING ERROR");
     return true;
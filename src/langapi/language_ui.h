@@ -31,6 +31,10 @@ public:
   virtual void show_symbol_table_xml_ui();
 
 protected:
+  /* The language handling `filename`, created on first use, or nullptr if
+   * the file can't be handled. Also sets config.language.lid. */
+  languaget *get_language(const std::string &filename);
+
   /* The instance of this class manages the global migrate_namespace_lookup,
    * thus it cannot be copied. These functions are protected in order for
    * derived classes to opt-into move support. */
@@ -277,8 +277,8 @@ private:
   /** The callback object to funnel all interactions with the context through.*/
   dereference_callbackt &dereference_callback;
   /** The number of failed symbols that we've generated (they're numbered
-   *  individually. */
-  static unsigned invalid_counter;
+   *  individually. Per thread, like the symex runs generating them. */
+  static thread_local unsigned invalid_counter;
   /** Whether or not we're operating in a big endian environment. Value for this
    *  is taken from config.ansi_c.endianness. */
   bool is_big_endian;
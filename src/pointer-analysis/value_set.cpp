@@ -18,8 +18,15 @@
 #include <util/std_expr.h>
 #include <util/type_byte_size.h>
 
-object_numberingt value_sett::object_numbering;
-object_number_numberingt value_sett::obj_numbering_refset;
+thread_local value_set_numberingt *value_sett::current_numbering = nullptr;
+
+value_set_numberingt &value_sett::default_numbering()
+{
+  // Not thread local: static analyses keep value sets in globals (e.g. the
+  // one of goto_cse), which outlive thread-local storage at exit
+  static value_set_numberingt numbering;
+  return numbering;
+}
 
 void value_sett::output(std::ostream &out) const
 {
@@ -63,7 +70,7 @@ void value_sett::output(std::ostream &out) const
          o_it != e.object_map.end();
          o_it++)
     {
-      const expr2tc &o = object_numbering[o_it->first];
+      const expr2tc &o = numbering().object_numbering[o_it->first];
 
       std::string result;
 
@@ -111,7 +118,7 @@ void value_sett::output(std::ostream &out) const
 
 expr2tc value_sett::to_expr(object_mapt::const_iterator it) const
 {
-  const expr2tc &object = object_numbering[it->first];
+  const expr2tc &object = numbering().object_numbering[it->first];
 
   if (is_invalid2t(object) || is_unknown2t(object))
     return object;
@@ -131,14 +138,22 @@ bool value_sett::make_union(const value_sett::valuest &new_values, bool keepnew)
 {
   bool result = false;
 
+  // Entries both sets still share are identical and merging them changes
+  // nothing, only look at the others.
+  std::vector<const valuest::value_type *> changed;
+  new_values.for_each_unshared(values, [&changed](const auto &new_value) {
+    changed.push_back(&new_value);
+  });
+
   // Iterate over all new values; if they're in the current value set, merge
   // them. If not, only merge it in if keepnew is true.
-  for (const auto &new_value : new_values)
+  for (const valuest::value_type *new_value_ptr : changed)
   {
-    valuest::iterator it2 = values.find(new_value.first);
+    const valuest::value_type &new_value = *new_value_ptr;
+    entryt *e = values.find_writable(new_value.first);
 
     // If the new variable isn't in this set
-    if (it2 == values.end())
+    if (e == nullptr)
     {
       // We always track these when merging value sets, as these store data
       // that's transferred back and forth between function calls. So, the
@@ -149,7 +164,7 @@ bool value_sett::make_union(const value_sett::valuest &new_values, bool keepnew)
           "value_set::dynamic_object") ||
         new_value.second.identifier == "value_set::return_value" || keepnew)
       {
-        values.insert(new_value);
+        values.insert(new_value.first, new_value.second);
         result = true;
       }
 
@@ -157,10 +172,9 @@ bool value_sett::make_union(const value_sett::valuest &new_values, bool keepnew)
     }
 
     // The variable was in this set, merge the values.
-    entryt &e = it2->second;
     const entryt &new_e = new_value.second;
 
-    if (make_union(e.object_map, new_e.object_map))
+    if (make_union(e->object_map, new_e.object_map))
       result = true;
   }
 
@@ -321,7 +335,7 @@ void value_sett::get_value_set_rec(
     // Then get the value set of all the pointers we might dereference to.
     for (const auto &it1 : reference_set)
     {
-      const expr2tc &object = object_numbering[it1.first];
+      const expr2tc &object = numbering().object_numbering[it1.first];
       get_value_set_rec(object, dest, suffix, original_type);
     }
 
@@ -673,7 +687,7 @@ void value_sett::get_value_set_rec(
         objectt object = it.second;
 
         unsigned int nat_align =
-          get_natural_alignment(object_numbering[it.first]);
+          get_natural_alignment(numbering().object_numbering[it.first]);
         unsigned int ptr_align = get_natural_alignment(ptr_op);
 
         if (is_const && object.offset_is_set)
@@ -864,7 +878,7 @@ void value_sett::get_reference_set_rec(const expr2tc &expr, object_mapt &dest)
 
     for (const auto &a_it : array_references)
     {
-      expr2tc object = object_numbering[a_it.first];
+      expr2tc object = numbering().object_numbering[a_it.first];
 
       if (is_unknown2t(object))
       {
@@ -931,7 +945,7 @@ void value_sett::get_reference_set_rec(const expr2tc &expr, object_mapt &dest)
 
     for (const auto &it : struct_references)
     {
-      expr2tc object = object_numbering[it.first];
+      expr2tc object = numbering().object_numbering[it.first];
 
       // An unknown or null base is /always/ unknown or null.
       if (
@@ -1180,7 +1194,7 @@ void value_sett::do_free(const expr2tc &op)
 
   for (const auto &it : value_set)
   {
-    const expr2tc &object = object_numbering[it.first];
+    const expr2tc &object = numbering().object_numbering[it.first];
 
     if (is_dynamic_object2t(object))
     {
@@ -1195,7 +1209,8 @@ void value_sett::do_free(const expr2tc &op)
 
   // mark these as 'may be invalid'
   // this, unfortunately, destroys the sharing
-  for (auto &value : values)
+  std::vector<std::pair<irep_idt, object_mapt>> updates;
+  for (const auto &value : values)
   {
     object_mapt new_object_map;
 
@@ -1205,7 +1220,7 @@ void value_sett::do_free(const expr2tc &op)
          o_it != value.second.object_map.end();
          o_it++)
     {
-      const expr2tc &object = object_numbering[o_it->first];
+      const expr2tc &object = numbering().object_numbering[o_it->first];
 
       if (is_dynamic_object2t(object))
       {
@@ -1229,8 +1244,12 @@ void value_sett::do_free(const expr2tc &op)
     }
 
     if (changed)
-      value.second.object_map = new_object_map;
+      updates.emplace_back(value.first, std::move(new_object_map));
   }
+
+  // Only unshare the entries that changed, once we're done iterating
+  for (auto &[name, object_map] : updates)
+    values.find_writable(name)->object_map = std::move(object_map);
 }
 
 void value_sett::assign_rec(
@@ -1271,7 +1290,7 @@ void value_sett::assign_rec(
 
     for (const auto &it : reference_set)
     {
-      const expr2tc obj = object_numbering[it.first];
+      const expr2tc obj = numbering().object_numbering[it.first];
 
       if (!is_unknown2t(obj) && !is_invalid2t(obj))
         assign_rec(obj, values_rhs, suffix, add_to_sets);
@@ -1545,15 +1564,16 @@ void value_sett::dump() const
 
 void value_sett::obj_numbering_ref(unsigned int num)
 {
-  obj_numbering_refset[num]++;
+  numbering().obj_numbering_refset[num]++;
 }
 
 void value_sett::obj_numbering_deref(unsigned int num)
 {
-  unsigned int refcount = --obj_numbering_refset[num];
+  value_set_numberingt &n = numbering();
+  unsigned int refcount = --n.obj_numbering_refset[num];
   if (refcount == 0)
   {
-    object_numbering.erase(num);
-    obj_numbering_refset.erase(num);
+    n.object_numbering.erase(num);
+    n.obj_numbering_refset.erase(num);
   }
 }
@@ -7,6 +7,7 @@
 #include <util/mp_arith.h>
 #include <util/namespace.h>
 #include <util/numbering.h>
+#include <util/persistent_map.h>
 #include <util/type_byte_size.h>
 
 /** Code for tracking "value sets" across assignments in ESBMC.
@@ -36,16 +37,32 @@
  *
  *  The only data element stored is a map from l1 variable names (as strings)
  *  to a record of what objects are stored. Data objects are numbered, with the
- *  mapping for that stored in a global variable, value_sett::object_numbering,
- *  (which will explode into multithreaded death cakes in the future). The
- *  primary interfaces to the value_sett object itself are the 'assign' method
- *  (for interpreting a variable assignment) and the get_value_set method, that
- *  takes a variable and returns the set of things it might point at.
+ *  mapping for that stored in a value_set_numberingt owned by the analysis
+ *  (e.g. the symex run) the value sets belong to, see value_sett::numbering.
+ *  The primary interfaces to the value_sett object itself are the 'assign'
+ *  method (for interpreting a variable assignment) and the get_value_set
+ *  method, that takes a variable and returns the set of things it might
+ *  point at.
  */
 
 typedef hash_numbering<expr2tc, irep2_hash> object_numberingt;
 typedef hash_numbering<unsigned, std::hash<unsigned>> object_number_numberingt;
 
+/** Numbering of the objects that value sets point at, together with the
+ *  number of object maps referring to each of them. Entries are dropped once
+ *  no object map refers to them any more.
+ *
+ *  Every value set of one analysis has to use the same numbering, and nothing
+ *  else may touch it concurrently. Each symex run owns its own (see
+ *  reachability_treet), so independent runs can execute in parallel threads
+ *  and the whole table is released with the run. */
+class value_set_numberingt
+{
+public:
+  object_numberingt object_numbering;
+  object_number_numberingt obj_numbering_refset;
+};
+
 class value_sett
 {
 public:
@@ -146,7 +163,7 @@ public:
 
   /** Datatype for a value set: stores a mapping between some integers and
    *  additional reference data in an objectt object. The integers are indexes
-   *  into value_sett::object_numbering, which identifies the l1 variable
+   *  into the current value_set_numberingt, which identifies the l1 variable
    *  being referred to. */
   typedef std::unordered_map<unsigned, objectt> object_mapt;
   class object_map_dt
@@ -245,8 +262,9 @@ public:
 
   /** Type of the value-set containing structure. A hash map mapping variables
    *  to an entryt, storing the value set of objects a variable might point
-   *  at. */
-  typedef std::unordered_map<irep_idt, entryt, irep_id_hash> valuest;
+   *  at. Copies share their entries, so that the value sets saved at branch
+   *  points are cheap. */
+  typedef persistent_mapt<irep_idt, entryt, irep_id_hash> valuest;
 
   /** Get the natural alignment unit of a reference to e. I don't know a more
    *  appropriate term, but if we were to have an offset into e, then what is
@@ -327,13 +345,14 @@ public:
 
   bool insert(object_mapt &dest, const expr2tc &src, const BigInt &offset) const
   {
-    return insert(dest, object_numbering.number(src), objectt(true, offset));
+    return insert(
+      dest, numbering().object_numbering.number(src), objectt(true, offset));
   }
 
   /** Insert an object record into the given object map. This method has
    *  various overloaded instances, that all descend to this particular method.
    *  The essential elements are a) an object map, b) an l1 data object or
-   *  the index number (in value_sett::object_numbering) that identifies
+   *  the index number (in the current object numbering) that identifies
    *  it, and c) the offset data for this record.
    *
    *  Rather than just adding this pointer record to the object map, this
@@ -344,7 +363,7 @@ public:
    *
    *  @param dest The object map to insert this record into.
    *  @param n The identifier for the object being referrred to, as indexed by
-   *         the value_set::object_numbering mapping.
+   *         the value_sett::numbering() mapping.
    *  @param object The offset data for the pointer record being inserted.
    */
   bool insert(object_mapt &dest, unsigned n, const objectt &object) const
@@ -359,7 +378,7 @@ public:
 
     object_mapt::iterator it2 = dest.find(n);
     objectt &old = it2->second;
-    const expr2tc &expr_obj = object_numbering[n];
+    const expr2tc &expr_obj = numbering().object_numbering[n];
 
     if (old.offset_is_set && object.offset_is_set)
     {
@@ -404,7 +423,7 @@ public:
   bool
   insert(object_mapt &dest, const expr2tc &expr, const objectt &object) const
   {
-    return insert(dest, object_numbering.number(expr), object);
+    return insert(dest, numbering().object_numbering.number(expr), object);
   }
 
   /** Remove the given pointer value set from the map.
@@ -474,10 +493,7 @@ public:
   {
     std::string index = id2string(e.identifier) + e.suffix;
 
-    std::pair<valuest::iterator, bool> r =
-      values.insert(std::pair<irep_idt, entryt>(index, e));
-
-    return r.first->second;
+    return *values.insert(index, e).first;
   }
 
   /** Add a value set for each variable in the given list. */
@@ -649,14 +665,48 @@ protected:
   static void obj_numbering_ref(unsigned int num);
   static void obj_numbering_deref(unsigned int num);
 
+public:
+  /** Numbering used by value sets on the calling thread -- i.e., the numbers
+   *  in the map of a @ref object_mapt. This is the one installed by the
+   *  innermost numbering_scopet, or a process-wide default one for analyses
+   *  that don't install their own (which must then stay on one thread). */
+  static value_set_numberingt &numbering()
+  {
+    return current_numbering ? *current_numbering : default_numbering();
+  }
+
+  /** Makes value sets on this thread use the given numbering until the scope
+   *  ends. Every value set created in the scope must be destroyed inside a
+   *  scope for the same numbering. */
+  class numbering_scopet
+  {
+  public:
+    explicit numbering_scopet(value_set_numberingt &numbering)
+      : prev(current_numbering)
+    {
+      current_numbering = &numbering;
+    }
+
+    ~numbering_scopet()
+    {
+      current_numbering = prev;
+    }
+
+    numbering_scopet(const numbering_scopet &) = delete;
+    numbering_scopet &operator=(const numbering_scopet &) = delete;
+
+  private:
+    value_set_numberingt *prev;
+  };
+
+private:
+  static thread_local value_set_numberingt *current_numbering;
+  static value_set_numberingt &default_numbering();
+
 public:
   //********************************** Members ***********************************
   /** Some crazy static analysis tool. */
   unsigned location_number;
-  /** Object to assign numbers to objects -- i.e., the numbers in the map of
-   *  a @ref object_mapt. Static and bad. */
-  static object_numberingt object_numbering;
-  static object_number_numberingt obj_numbering_refset;
 
   /** Storage for all the value sets for all the variables in the program. See
    *  @ref entryt for the format of the string used as an index. */
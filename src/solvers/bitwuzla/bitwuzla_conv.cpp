@@ -37,6 +37,12 @@ bitwuzla_convt::bitwuzla_convt(const namespacet &ns, const optionst &options)
   bitwuzla_set_option(bitw_options, BITWUZLA_OPT_PRODUCE_MODELS, 1);
   bitwuzla_set_abort_callback(bitwuzla_error_handler);
   bitw = bitwuzla_new(bitw_term_manager, bitw_options);
+  bitwuzla_set_termination_callback(
+    bitw,
+    [](void *state) -> int32_t {
+      return static_cast<bitwuzla_convt *>(state)->interrupted;
+    },
+    this);
 }
 
 bitwuzla_convt::~bitwuzla_convt()
@@ -78,6 +84,11 @@ smt_convt::resultt bitwuzla_convt::dec_solve()
   return P_ERROR;
 }
 
+void bitwuzla_convt::interrupt()
+{
+  interrupted = true;
+}
+
 const std::string bitwuzla_convt::solver_text()
 {
   std::string ss = "Bitwuzla ";
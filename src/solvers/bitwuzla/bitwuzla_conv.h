@@ -1,6 +1,7 @@
 #ifndef _ESBMC_SOLVERS_BITWUZLA_BITWUZLA_CONV_H_
 #define _ESBMC_SOLVERS_BITWUZLA_BITWUZLA_CONV_H_
 
+#include <atomic>
 #include <cstdio>
 #include <solvers/smt/smt_conv.h>
 #include <irep2/irep2.h>
@@ -29,6 +30,11 @@ public:
   void push_ctx() override;
   void pop_ctx() override;
   resultt dec_solve() override;
+  void interrupt() override;
+  bool can_interrupt() const override
+  {
+    return true;
+  }
   const std::string solver_text() override;
 
   void assert_ast(smt_astt a) override;
@@ -108,6 +114,8 @@ public:
   Bitwuzla *bitw;
   BitwuzlaOptions *bitw_options;
   BitwuzlaTermManager *bitw_term_manager;
+  /// Polled by the solver while searching, see interrupt()
+  std::atomic<bool> interrupted = false;
 
   symtabt symtable;
 };
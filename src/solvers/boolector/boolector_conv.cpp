@@ -38,6 +38,12 @@ boolector_convt::boolector_convt(const namespacet &ns, const optionst &options)
   if (options.get_bool_option("smt-during-symex"))
     boolector_set_opt(btor, BTOR_OPT_INCREMENTAL, 1);
   boolector_set_abort(error_handler);
+  boolector_set_term(
+    btor,
+    [](void *state) -> int32_t {
+      return static_cast<boolector_convt *>(state)->interrupted;
+    },
+    this);
 }
 
 boolector_convt::~boolector_convt()
@@ -76,6 +82,11 @@ smt_convt::resultt boolector_convt::dec_solve()
   return P_ERROR;
 }
 
+void boolector_convt::interrupt()
+{
+  interrupted = true;
+}
+
 const std::string boolector_convt::solver_text()
 {
   std::string ss = "Boolector ";
@@ -58,6 +58,12 @@ mathsat_convt::mathsat_convt(const namespacet &ns, const optionst &options)
   cfg = msat_parse_config(mathsat_config);
   msat_set_option(cfg, "model_generation", "true");
   env = msat_create_env(cfg);
+  msat_set_termination_test(
+    env,
+    [](void *state) -> int {
+      return static_cast<mathsat_convt *>(state)->interrupted;
+    },
+    this);
 }
 
 mathsat_convt::~mathsat_convt()
@@ -97,6 +103,11 @@ smt_convt::resultt mathsat_convt::dec_solve()
   return smt_convt::P_ERROR;
 }
 
+void mathsat_convt::interrupt()
+{
+  interrupted = true;
+}
+
 bool mathsat_convt::get_bool(smt_astt a)
 {
   const mathsat_smt_ast *mast = to_solver_smt_ast<mathsat_smt_ast>(a);
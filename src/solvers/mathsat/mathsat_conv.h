@@ -1,6 +1,7 @@
 #ifndef _ESBMC_SOLVERS_MATHSAT_MATHSAT_CONV_H_
 #define _ESBMC_SOLVERS_MATHSAT_MATHSAT_CONV_H_
 
+#include <atomic>
 #include <mathsat.h>
 #include <solvers/smt/smt_conv.h>
 #include <solvers/smt/fp/fp_conv.h>
@@ -21,6 +22,11 @@ public:
   ~mathsat_convt() override;
 
   resultt dec_solve() override;
+  void interrupt() override;
+  bool can_interrupt() const override
+  {
+    return true;
+  }
   const std::string solver_text() override;
 
   void assert_ast(smt_astt a) override;
@@ -145,6 +151,8 @@ public:
   // MathSAT data.
   msat_config cfg;
   msat_env env;
+  /// Polled by the solver while searching, see interrupt()
+  std::atomic<bool> interrupted = false;
 
   // Flag to workaround the fact that MathSAT does not support fma. It's
   // set to true so every operation is converted using the fpapi
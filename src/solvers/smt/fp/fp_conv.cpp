@@ -27,6 +27,33 @@ fp_convt::fp_convt(smt_convt *_ctx) : ctx(_ctx)
 {
 }
 
+void fp_convt::push_fp_ctx()
+{
+  circuit_levels.emplace_back();
+}
+
+void fp_convt::pop_fp_ctx()
+{
+  for (const circuit_keyt &key : circuit_levels.back())
+    circuits.erase(key);
+  circuit_levels.pop_back();
+}
+
+const fp_convt::circuit_outputst *
+fp_convt::find_circuit(const circuit_keyt &key) const
+{
+  auto it = circuits.find(key);
+  return it == circuits.end() ? nullptr : &it->second;
+}
+
+void fp_convt::add_circuit(
+  const circuit_keyt &key,
+  const circuit_outputst &outputs)
+{
+  if (circuits.emplace(key, outputs).second)
+    circuit_levels.back().push_back(key);
+}
+
 smt_astt fp_convt::mk_smt_fpbv(const ieee_floatt &thereal)
 {
   smt_sortt s = ctx->mk_bvfp_sort(thereal.spec.e, thereal.spec.f);
@@ -249,6 +276,10 @@ smt_astt fp_convt::mk_smt_nearbyint_from_float(smt_astt x, smt_astt rm)
 
 smt_astt fp_convt::mk_smt_fpbv_sqrt(smt_astt x, smt_astt rm)
 {
+  const circuit_keyt key = {circuitt::SQRT, {x, rm, nullptr, nullptr}};
+  if (const circuit_outputst *c = find_circuit(key))
+    return (*c)[0];
+
   unsigned ebits = x->sort->get_exponent_width();
   unsigned sbits = x->sort->get_significand_width();
 
@@ -348,12 +379,18 @@ smt_astt fp_convt::mk_smt_fpbv_sqrt(smt_astt x, smt_astt rm)
   smt_astt result = ctx->mk_ite(c4, v4, v5);
   result = ctx->mk_ite(c3, v3, result);
   result = ctx->mk_ite(c2, v2, result);
-  return ctx->mk_ite(c1, v1, result);
+  smt_astt out = ctx->mk_ite(c1, v1, result);
+  add_circuit(key, {out});
+  return out;
 }
 
 smt_astt
 fp_convt::mk_smt_fpbv_fma(smt_astt x, smt_astt y, smt_astt z, smt_astt rm)
 {
+  const circuit_keyt key = {circuitt::FMA, {x, y, z, rm}};
+  if (const circuit_outputst *c = find_circuit(key))
+    return (*c)[0];
+
   assert(x->sort->get_data_width() == y->sort->get_data_width());
   assert(x->sort->get_exponent_width() == y->sort->get_exponent_width());
   assert(x->sort->get_data_width() == z->sort->get_data_width());
@@ -630,7 +667,9 @@ fp_convt::mk_smt_fpbv_fma(smt_astt x, smt_astt y, smt_astt z, smt_astt rm)
   result = ctx->mk_ite(c4, v4, result);
   result = ctx->mk_ite(c3, v3, result);
   result = ctx->mk_ite(c2, v2, result);
-  return ctx->mk_ite(c1, v1, result);
+  smt_astt out = ctx->mk_ite(c1, v1, result);
+  add_circuit(key, {out});
+  return out;
 }
 
 smt_astt fp_convt::mk_to_bv(smt_astt x, bool is_signed, std::size_t width)
@@ -1230,6 +1269,10 @@ static void add_core(
 
 smt_astt fp_convt::mk_smt_fpbv_add(smt_astt x, smt_astt y, smt_astt rm)
 {
+  const circuit_keyt key = {circuitt::ADD, {x, y, rm, nullptr}};
+  if (const circuit_outputst *c = find_circuit(key))
+    return (*c)[0];
+
   assert(x->sort->get_data_width() == y->sort->get_data_width());
   assert(x->sort->get_exponent_width() == y->sort->get_exponent_width());
 
@@ -1324,17 +1367,29 @@ smt_astt fp_convt::mk_smt_fpbv_add(smt_astt x, smt_astt y, smt_astt rm)
   result = ctx->mk_ite(c4, v4, result);
   result = ctx->mk_ite(c3, v3, result);
   result = ctx->mk_ite(c2, v2, result);
-  return ctx->mk_ite(c1, v1, result);
+  smt_astt out = ctx->mk_ite(c1, v1, result);
+  add_circuit(key, {out});
+  return out;
 }
 
 smt_astt fp_convt::mk_smt_fpbv_sub(smt_astt lhs, smt_astt rhs, smt_astt rm)
 {
+  const circuit_keyt key = {circuitt::SUB, {lhs, rhs, rm, nullptr}};
+  if (const circuit_outputst *c = find_circuit(key))
+    return (*c)[0];
+
   smt_astt t = mk_smt_fpbv_neg(rhs);
-  return mk_smt_fpbv_add(lhs, t, rm);
+  smt_astt out = mk_smt_fpbv_add(lhs, t, rm);
+  add_circuit(key, {out});
+  return out;
 }
 
 smt_astt fp_convt::mk_smt_fpbv_mul(smt_astt x, smt_astt y, smt_astt rm)
 {
+  const circuit_keyt key = {circuitt::MUL, {x, y, rm, nullptr}};
+  if (const circuit_outputst *c = find_circuit(key))
+    return (*c)[0];
+
   assert(x->sort->get_data_width() == y->sort->get_data_width());
   assert(x->sort->get_exponent_width() == y->sort->get_exponent_width());
 
@@ -1432,11 +1487,17 @@ smt_astt fp_convt::mk_smt_fpbv_mul(smt_astt x, smt_astt y, smt_astt rm)
   result = ctx->mk_ite(c4, v4, result);
   result = ctx->mk_ite(c3, v3, result);
   result = ctx->mk_ite(c2, v2, result);
-  return ctx->mk_ite(c1, v1, result);
+  smt_astt out = ctx->mk_ite(c1, v1, result);
+  add_circuit(key, {out});
+  return out;
 }
 
 smt_astt fp_convt::mk_smt_fpbv_div(smt_astt x, smt_astt y, smt_astt rm)
 {
+  const circuit_keyt key = {circuitt::DIV, {x, y, rm, nullptr}};
+  if (const circuit_outputst *c = find_circuit(key))
+    return (*c)[0];
+
   assert(x->sort->get_data_width() == y->sort->get_data_width());
   assert(x->sort->get_exponent_width() == y->sort->get_exponent_width());
 
@@ -1548,7 +1609,9 @@ smt_astt fp_convt::mk_smt_fpbv_div(smt_astt x, smt_astt y, smt_astt rm)
   result = ctx->mk_ite(c4, v4, result);
   result = ctx->mk_ite(c3, v3, result);
   result = ctx->mk_ite(c2, v2, result);
-  return ctx->mk_ite(c1, v1, result);
+  smt_astt out = ctx->mk_ite(c1, v1, result);
+  add_circuit(key, {out});
+  return out;
 }
 
 smt_astt fp_convt::mk_smt_fpbv_eq(smt_astt lhs, smt_astt rhs)
@@ -1634,6 +1697,10 @@ smt_astt fp_convt::mk_smt_fpbv_lte(smt_astt lhs, smt_astt rhs)
 
 smt_astt fp_convt::mk_smt_fpbv_is_nan(smt_astt op)
 {
+  const circuit_keyt key = {circuitt::IS_NAN, {op, nullptr, nullptr, nullptr}};
+  if (const circuit_outputst *c = find_circuit(key))
+    return (*c)[0];
+
   // Extract the exponent and significand
   smt_astt exp = extract_exponent(ctx, op);
   smt_astt sig = extract_significand(ctx, op);
@@ -1645,11 +1712,17 @@ smt_astt fp_convt::mk_smt_fpbv_is_nan(smt_astt op)
   smt_astt sig_is_zero = ctx->mk_eq(sig, zero);
   smt_astt sig_is_not_zero = ctx->mk_not(sig_is_zero);
   smt_astt exp_is_top = ctx->mk_eq(exp, top_exp);
-  return ctx->mk_and(exp_is_top, sig_is_not_zero);
+  smt_astt out = ctx->mk_and(exp_is_top, sig_is_not_zero);
+  add_circuit(key, {out});
+  return out;
 }
 
 smt_astt fp_convt::mk_smt_fpbv_is_inf(smt_astt op)
 {
+  const circuit_keyt key = {circuitt::IS_INF, {op, nullptr, nullptr, nullptr}};
+  if (const circuit_outputst *c = find_circuit(key))
+    return (*c)[0];
+
   // Extract the exponent and significand
   smt_astt exp = extract_exponent(ctx, op);
   smt_astt sig = extract_significand(ctx, op);
@@ -1660,11 +1733,18 @@ smt_astt fp_convt::mk_smt_fpbv_is_inf(smt_astt op)
   smt_astt zero = ctx->mk_smt_bv(BigInt(0), sig->sort->get_data_width());
   smt_astt sig_is_zero = ctx->mk_eq(sig, zero);
   smt_astt exp_is_top = ctx->mk_eq(exp, top_exp);
-  return ctx->mk_and(exp_is_top, sig_is_zero);
+  smt_astt out = ctx->mk_and(exp_is_top, sig_is_zero);
+  add_circuit(key, {out});
+  return out;
 }
 
 smt_astt fp_convt::mk_is_denormal(smt_astt op)
 {
+  const circuit_keyt key = {
+    circuitt::IS_DENORMAL, {op, nullptr, nullptr, nullptr}};
+  if (const circuit_outputst *c = find_circuit(key))
+    return (*c)[0];
+
   // Extract the exponent and significand
   smt_astt exp = extract_exponent(ctx, op);
 
@@ -1672,11 +1752,18 @@ smt_astt fp_convt::mk_is_denormal(smt_astt op)
   smt_astt zexp = ctx->mk_eq(exp, zero);
   smt_astt is_zero = mk_smt_fpbv_is_zero(op);
   smt_astt n_is_zero = ctx->mk_not(is_zero);
-  return ctx->mk_and(n_is_zero, zexp);
+  smt_astt out = ctx->mk_and(n_is_zero, zexp);
+  add_circuit(key, {out});
+  return out;
 }
 
 smt_astt fp_convt::mk_smt_fpbv_is_normal(smt_astt op)
 {
+  const circuit_keyt key = {
+    circuitt::IS_NORMAL, {op, nullptr, nullptr, nullptr}};
+  if (const circuit_outputst *c = find_circuit(key))
+    return (*c)[0];
+
   // Extract the exponent and significand
   smt_astt exp = extract_exponent(ctx, op);
 
@@ -1690,11 +1777,17 @@ smt_astt fp_convt::mk_smt_fpbv_is_normal(smt_astt op)
 
   smt_astt or_ex = ctx->mk_or(is_special, is_denormal);
   or_ex = ctx->mk_or(is_zero, or_ex);
-  return ctx->mk_not(or_ex);
+  smt_astt out = ctx->mk_not(or_ex);
+  add_circuit(key, {out});
+  return out;
 }
 
 smt_astt fp_convt::mk_smt_fpbv_is_zero(smt_astt op)
 {
+  const circuit_keyt key = {circuitt::IS_ZERO, {op, nullptr, nullptr, nullptr}};
+  if (const circuit_outputst *c = find_circuit(key))
+    return (*c)[0];
+
   // Both -0 and 0 should return true
 
   // Compare with '0'
@@ -1703,7 +1796,9 @@ smt_astt fp_convt::mk_smt_fpbv_is_zero(smt_astt op)
   // Extract everything but the sign bit
   smt_astt ew_sw = extract_exp_sig(ctx, op);
 
-  return ctx->mk_eq(ew_sw, zero);
+  smt_astt out = ctx->mk_eq(ew_sw, zero);
+  add_circuit(key, {out});
+  return out;
 }
 
 smt_astt fp_convt::mk_smt_fpbv_is_negative(smt_astt op)
@@ -1748,6 +1843,18 @@ void fp_convt::unpack(
   smt_astt &lz,
   bool normalize)
 {
+  const circuit_keyt key = {
+    normalize ? circuitt::UNPACK_NORMALIZED : circuitt::UNPACK,
+    {src, nullptr, nullptr, nullptr}};
+  if (const circuit_outputst *c = find_circuit(key))
+  {
+    sgn = (*c)[0];
+    sig = (*c)[1];
+    exp = (*c)[2];
+    lz = (*c)[3];
+    return;
+  }
+
   unsigned sbits = src->sort->get_significand_width();
   unsigned ebits = src->sort->get_exponent_width();
 
@@ -1809,6 +1916,8 @@ void fp_convt::unpack(
   assert(sgn->sort->get_data_width() == 1);
   assert(sig->sort->get_data_width() == sbits);
   assert(exp->sort->get_data_width() == ebits);
+
+  add_circuit(key, {sgn, sig, exp, lz});
 }
 
 smt_astt fp_convt::mk_unbias(smt_astt &src)
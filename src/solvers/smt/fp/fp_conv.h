@@ -1,8 +1,12 @@
 #ifndef SOLVERS_SMT_FP_CONV_H_
 #define SOLVERS_SMT_FP_CONV_H_
 
+#include <array>
+#include <boost/functional/hash.hpp>
 #include <solvers/smt/smt_ast.h>
 #include <solvers/smt/smt_sort.h>
+#include <unordered_map>
+#include <vector>
 
 class fp_convt
 {
@@ -219,9 +223,83 @@ public:
    */
   virtual smt_astt mk_from_fp_to_bv(smt_astt op);
 
-private:
+  /** Check the operations encoded as approximations against the solver's
+   *  current model, and encode the ones it contradicts exactly. Only called
+   *  after the solver found the formula satisfiable.
+   *  @return Whether any operation was refined, i.e., whether the formula
+   *          has to be solved again. */
+  virtual bool refine_approximations()
+  {
+    return false;
+  }
+
+  virtual void push_fp_ctx();
+  virtual void pop_fp_ctx();
+
+  /** Number of circuits kept for sharing with later operations */
+  size_t shared_circuits() const
+  {
+    return circuits.size();
+  }
+
+protected:
   smt_convt *ctx;
 
+private:
+  /* Circuits are shared between calls on the same operand ASTs: operations
+   * repeated by loop unrolling or recomputed values get the circuit built the
+   * first time, and all operations on one operand share its unpacking and
+   * classification. */
+  enum class circuitt
+  {
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    FMA,
+    SQRT,
+    UNPACK,
+    UNPACK_NORMALIZED,
+    IS_NAN,
+    IS_INF,
+    IS_ZERO,
+    IS_NORMAL,
+    IS_DENORMAL
+  };
+
+  struct circuit_keyt
+  {
+    circuitt kind;
+    std::array<smt_astt, 4> args;
+
+    bool operator==(const circuit_keyt &other) const
+    {
+      return kind == other.kind && args == other.args;
+    }
+  };
+
+  struct circuit_key_hash
+  {
+    size_t operator()(const circuit_keyt &k) const
+    {
+      size_t seed = static_cast<size_t>(k.kind);
+      for (smt_astt a : k.args)
+        boost::hash_combine(seed, a);
+      return seed;
+    }
+  };
+
+  typedef std::array<smt_astt, 4> circuit_outputst;
+
+  std::unordered_map<circuit_keyt, circuit_outputst, circuit_key_hash>
+    circuits;
+  /* The keys added in each context level. ASTs are freed when their context
+   * is popped, so their circuits must be forgotten then, too. */
+  std::vector<std::vector<circuit_keyt>> circuit_levels{1};
+
+  const circuit_outputst *find_circuit(const circuit_keyt &key) const;
+  void add_circuit(const circuit_keyt &key, const circuit_outputst &outputs);
+
   void unpack(
     smt_astt &src,
     smt_astt &sgn,
@@ -0,0 +1,159 @@
+#include <solvers/smt/smt_conv.h>
+#include <solvers/smt/fp/fp_refinement.h>
+#include <util/arith_tools.h>
+
+static smt_astt extract_signbit(smt_convt *ctx, smt_astt fp)
+{
+  return ctx->mk_extract(
+    fp, fp->sort->get_data_width() - 1, fp->sort->get_data_width() - 1);
+}
+
+fp_refinement_convt::fp_refinement_convt(smt_convt *_ctx) : fp_convt(_ctx)
+{
+}
+
+smt_astt
+fp_refinement_convt::mk_smt_fpbv_add(smt_astt lhs, smt_astt rhs, smt_astt rm)
+{
+  // Subtractions negate rhs and end up here as well
+  return approximate(opt::ADD, lhs, rhs, rm);
+}
+
+smt_astt
+fp_refinement_convt::mk_smt_fpbv_mul(smt_astt lhs, smt_astt rhs, smt_astt rm)
+{
+  return approximate(opt::MUL, lhs, rhs, rm);
+}
+
+smt_astt
+fp_refinement_convt::mk_smt_fpbv_div(smt_astt lhs, smt_astt rhs, smt_astt rm)
+{
+  return approximate(opt::DIV, lhs, rhs, rm);
+}
+
+smt_astt fp_refinement_convt::approximate(
+  opt op,
+  smt_astt lhs,
+  smt_astt rhs,
+  smt_astt rm)
+{
+  assert(lhs->sort->get_data_width() == rhs->sort->get_data_width());
+  smt_astt result = ctx->mk_fresh(lhs->sort, "fp_approx::");
+
+  // NaN operands always give the NaN the exact encoding creates
+  std::size_t ebits = lhs->sort->get_exponent_width();
+  std::size_t sbits = lhs->sort->get_significand_width();
+  smt_astt some_nan =
+    ctx->mk_or(mk_smt_fpbv_is_nan(lhs), mk_smt_fpbv_is_nan(rhs));
+  ctx->assert_ast(ctx->mk_implies(
+    some_nan, ctx->mk_eq(result, mk_smt_fpbv_nan(false, ebits, sbits))));
+
+  // Products and quotients that are numbers take the xor of the signs
+  if (op != opt::ADD)
+  {
+    smt_astt sign = ctx->mk_bvxor(
+      extract_signbit(ctx, lhs), extract_signbit(ctx, rhs));
+    ctx->assert_ast(ctx->mk_implies(
+      ctx->mk_not(mk_smt_fpbv_is_nan(result)),
+      ctx->mk_eq(extract_signbit(ctx, result), sign)));
+  }
+
+  approximations.push_back({op, lhs, rhs, rm, result, 0});
+  return result;
+}
+
+smt_astt fp_refinement_convt::exact(const approximationt &a)
+{
+  switch (a.op)
+  {
+  case opt::ADD:
+    return fp_convt::mk_smt_fpbv_add(a.lhs, a.rhs, a.rm);
+  case opt::MUL:
+    return fp_convt::mk_smt_fpbv_mul(a.lhs, a.rhs, a.rm);
+  case opt::DIV:
+    return fp_convt::mk_smt_fpbv_div(a.lhs, a.rhs, a.rm);
+  }
+  abort();
+}
+
+bool fp_refinement_convt::holds_in_model(const approximationt &a)
+{
+  // ieee_floatt doesn't implement rounding to away
+  BigInt rm = ctx->get_bv(a.rm, false);
+  if (
+    rm != ieee_floatt::ROUND_TO_EVEN && rm != ieee_floatt::ROUND_TO_PLUS_INF &&
+    rm != ieee_floatt::ROUND_TO_MINUS_INF && rm != ieee_floatt::ROUND_TO_ZERO)
+    return false;
+
+  ieee_floatt value = get_fpbv(a.lhs);
+  value.rounding_mode = (ieee_floatt::rounding_modet)rm.to_uint64();
+  const ieee_floatt rhs = get_fpbv(a.rhs);
+  switch (a.op)
+  {
+  case opt::ADD:
+    value += rhs;
+    break;
+  case opt::MUL:
+    value *= rhs;
+    break;
+  case opt::DIV:
+    value /= rhs;
+    break;
+  }
+
+  // The exact encoding always creates the same positive, quiet NaN
+  const ieee_float_spect &spec = value.spec;
+  BigInt expected = value.is_NaN()
+                      ? (power(2, spec.e) - 1) * power(2, spec.f) + 1
+                      : value.pack();
+  return ctx->get_bv(a.result, false) == expected;
+}
+
+bool fp_refinement_convt::refine_approximations()
+{
+  if (approximations.empty())
+    return false;
+
+  rounds++;
+  size_t refined = 0;
+  for (approximationt &a : approximations)
+  {
+    if (a.refined_level != 0 || holds_in_model(a))
+      continue;
+
+    ctx->assert_ast(ctx->mk_eq(a.result, exact(a)));
+    a.refined_level = approximations_sizes.size() + 1;
+    refined++;
+  }
+
+  size_t total = 0;
+  for (const approximationt &a : approximations)
+    total += a.refined_level != 0;
+  log_status(
+    "FP refinement round {}: {} operation(s) refined, {} of {} exact",
+    rounds,
+    refined,
+    total,
+    approximations.size());
+
+  return refined != 0;
+}
+
+void fp_refinement_convt::push_fp_ctx()
+{
+  fp_convt::push_fp_ctx();
+  approximations_sizes.push_back(approximations.size());
+}
+
+void fp_refinement_convt::pop_fp_ctx()
+{
+  fp_convt::pop_fp_ctx();
+
+  // The operations of the popped context are gone, and so are the exact
+  // encodings asserted in it
+  approximations.resize(approximations_sizes.back());
+  approximations_sizes.pop_back();
+  for (approximationt &a : approximations)
+    if (a.refined_level > approximations_sizes.size() + 1)
+      a.refined_level = 0;
+}
@@ -0,0 +1,63 @@
+#ifndef SOLVERS_SMT_FP_REFINEMENT_H_
+#define SOLVERS_SMT_FP_REFINEMENT_H_
+
+#include <solvers/smt/fp/fp_conv.h>
+#include <vector>
+
+/** Bit-blasts floating-point like fp_convt, except for additions,
+ *  subtractions, multiplications and divisions. Their results start as fresh
+ *  variables constrained only by NaN propagation and, for multiplications
+ *  and divisions, the sign of the result. Such an over-approximation makes
+ *  unsat answers final. After a sat answer, refine_approximations() checks
+ *  every approximated operation against ieee_floatt on the model's values,
+ *  and only the operations the model contradicts get their full encoding.
+ *  See --fp-refinement. */
+class fp_refinement_convt : public fp_convt
+{
+public:
+  explicit fp_refinement_convt(smt_convt *_ctx);
+
+  smt_astt mk_smt_fpbv_add(smt_astt lhs, smt_astt rhs, smt_astt rm) override;
+  smt_astt mk_smt_fpbv_mul(smt_astt lhs, smt_astt rhs, smt_astt rm) override;
+  smt_astt mk_smt_fpbv_div(smt_astt lhs, smt_astt rhs, smt_astt rm) override;
+
+  bool refine_approximations() override;
+
+  void push_fp_ctx() override;
+  void pop_fp_ctx() override;
+
+protected:
+  enum class opt
+  {
+    ADD,
+    MUL,
+    DIV
+  };
+
+  struct approximationt
+  {
+    opt op;
+    smt_astt lhs;
+    smt_astt rhs;
+    smt_astt rm;
+    smt_astt result;
+    /* Context level the exact encoding was asserted at, 0 if it wasn't */
+    unsigned refined_level;
+  };
+
+  std::vector<approximationt> approximations;
+  /* Number of approximations when each context was pushed */
+  std::vector<size_t> approximations_sizes;
+  /* Refinement rounds so far, for the log */
+  unsigned rounds = 0;
+
+  smt_astt approximate(opt op, smt_astt lhs, smt_astt rhs, smt_astt rm);
+
+  /* The full bit-blasted encoding of `a` */
+  smt_astt exact(const approximationt &a);
+
+  /* Whether the model agrees with ieee_floatt on the result of `a` */
+  bool holds_in_model(const approximationt &a);
+};
+
+#endif /* SOLVERS_SMT_FP_REFINEMENT_H_ */
@@ -1,4 +1,5 @@
 #include "irep2/irep2_expr.h"
+#include <algorithm>
 #include <cfloat>
 #include <iomanip>
 #include <set>
@@ -168,6 +169,7 @@ void smt_convt::push_ctx()
 {
   tuple_api->push_tuple_ctx();
   array_api->push_array_ctx();
+  fp_api->push_fp_ctx();
 
   addr_space_data.push_back(addr_space_data.back());
   addr_space_sym_num.push_back(addr_space_sym_num.back());
@@ -224,6 +226,7 @@ void smt_convt::pop_ctx()
 
   array_api->pop_array_ctx();
   tuple_api->pop_tuple_ctx();
+  fp_api->pop_fp_ctx();
 }
 
 smt_astt smt_convt::invert_ast(smt_astt a)
@@ -301,12 +304,8 @@ smt_astt smt_convt::convert_assign(const expr2tc &expr)
   // IMPORTANT: the cache is now a fundamental part of how some flatteners work,
   // in that one can choose to create a set of expressions and their ASTs, then
   // store them in the cache, rather than have a more sophisticated conversion.
-  {
-    const smt_cache_entryt e = {eq.side_1, side2, ctx_level};
-    // Lock automatically released when it goes out of scope
-    std::lock_guard lock(smt_cache_mutex);
-    smt_cache.insert(e);
-  }
+  const smt_cache_entryt e = {eq.side_1, side2, ctx_level};
+  smt_cache.insert(e);
 
   return side2;
 }
@@ -450,14 +449,86 @@ smt_astt smt_convt::apply_ieee754_semantics(
   return ieee_result;
 }
 
+/* Whether convert_node() converts all operands of an expression with this id
+ * before looking at the expression itself. The others convert their operands
+ * (if at all) in their own way. */
+static bool converts_operands_first(expr2t::expr_ids id)
+{
+  switch (id)
+  {
+  case expr2t::with_id:
+  case expr2t::constant_array_id:
+  case expr2t::constant_vector_id:
+  case expr2t::constant_array_of_id:
+  case expr2t::index_id:
+  case expr2t::address_of_id:
+  case expr2t::ieee_add_id:
+  case expr2t::ieee_sub_id:
+  case expr2t::ieee_mul_id:
+  case expr2t::ieee_div_id:
+  case expr2t::ieee_fma_id:
+  case expr2t::ieee_sqrt_id:
+  case expr2t::pointer_offset_id:
+  case expr2t::pointer_object_id:
+  case expr2t::pointer_capability_id:
+    return false;
+  default:
+    return true;
+  }
+}
+
 smt_astt smt_convt::convert_ast(const expr2tc &expr)
 {
+  smt_cachet::const_iterator cache_result = smt_cache.find(expr);
+  if (cache_result != smt_cache.end())
+    return cache_result->ast;
+
+  /* Walk the expression in post-order with an explicit stack, converting the
+   * operands before their parents, so that convert_node() finds them in the
+   * cache instead of recursing. Long if-then-else chains from phi functions
+   * would otherwise take one native stack frame per level. Operands are
+   * pushed in reverse so they are still converted left to right. Vectors are
+   * left to convert_node(), as it may distribute the operation first. */
+  std::vector<std::pair<const expr2tc *, bool>> stack = {{&expr, false}};
+  smt_astt a = nullptr;
+  while (!stack.empty())
   {
-    std::lock_guard lock(smt_cache_mutex);
-    smt_cachet::const_iterator cache_result = smt_cache.find(expr);
-    if (cache_result != smt_cache.end())
-      return (cache_result->ast);
+    const expr2tc &e = *stack.back().first;
+    if (stack.back().second)
+    {
+      stack.pop_back();
+      a = convert_node(e);
+      continue;
+    }
+
+    // Shared operands may have been converted since they were pushed
+    if (stack.size() > 1 && smt_cache.find(e) != smt_cache.end())
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    stack.back().second = true;
+    if (is_vector_type(e) || !converts_operands_first(e->expr_id))
+      continue;
+
+    const size_t first = stack.size();
+    e->foreach_operand([this, &stack](const expr2tc &op) {
+      if (smt_cache.find(op) == smt_cache.end())
+        stack.emplace_back(&op, false);
+    });
+    std::reverse(stack.begin() + first, stack.end());
   }
+
+  return a;
+}
+
+smt_astt smt_convt::convert_node(const expr2tc &expr)
+{
+  smt_cachet::const_iterator cache_result = smt_cache.find(expr);
+  if (cache_result != smt_cache.end())
+    return cache_result->ast;
+
   /* Vectors!
    *
    * Here we need special attention for Vectors, because of the way
@@ -470,64 +541,52 @@ smt_astt smt_convt::convert_ast(const expr2tc &expr)
   */
   if (is_vector_type(expr))
   {
+    // Cache the result under the vector expression too, or every parent
+    // converting it would distribute the operation again
+    auto distributed = [this, &expr](const expr2tc &e) {
+      smt_astt a = convert_ast(e);
+      const smt_cache_entryt entry = {expr, a, ctx_level};
+      smt_cache.insert(entry);
+      return a;
+    };
+
     if (is_neg2t(expr))
     {
-      return convert_ast(
+      return distributed(
         distribute_vector_operation(expr->expr_id, to_neg2t(expr).value));
     }
     if (is_bitnot2t(expr))
     {
-      return convert_ast(
+      return distributed(
         distribute_vector_operation(expr->expr_id, to_bitnot2t(expr).value));
     }
 
     const ieee_arith_2ops *ops = dynamic_cast<const ieee_arith_2ops *>(&*expr);
     if (ops)
     {
-      return convert_ast(distribute_vector_operation(
+      return distributed(distribute_vector_operation(
         ops->expr_id, ops->side_1, ops->side_2, ops->rounding_mode));
     }
     if (is_arith_expr(expr))
     {
       const arith_2ops &arith = dynamic_cast<const arith_2ops &>(*expr);
-      return convert_ast(
+      return distributed(
         distribute_vector_operation(arith.expr_id, arith.side_1, arith.side_2));
     }
     const bit_2ops *bit = dynamic_cast<const bit_2ops *>(&*expr);
     if (bit)
-      return convert_ast(
+      return distributed(
         distribute_vector_operation(bit->expr_id, bit->side_1, bit->side_2));
   }
 
   std::vector<smt_astt> args;
-
-  switch (expr->expr_id)
-  {
-  case expr2t::with_id:
-  case expr2t::constant_array_id:
-  case expr2t::constant_vector_id:
-  case expr2t::constant_array_of_id:
-  case expr2t::index_id:
-  case expr2t::address_of_id:
-  case expr2t::ieee_add_id:
-  case expr2t::ieee_sub_id:
-  case expr2t::ieee_mul_id:
-  case expr2t::ieee_div_id:
-  case expr2t::ieee_fma_id:
-  case expr2t::ieee_sqrt_id:
-  case expr2t::pointer_offset_id:
-  case expr2t::pointer_object_id:
-  case expr2t::pointer_capability_id:
-    break; // Don't convert their operands
-
-  default:
+  if (converts_operands_first(expr->expr_id))
   {
     // Convert all the arguments and store them in 'args'.
     args.reserve(expr->get_num_sub_exprs());
     expr->foreach_operand(
       [this, &args](const expr2tc &e) { args.push_back(convert_ast(e)); });
   }
-  }
 
   smt_astt a;
   switch (expr->expr_id)
@@ -1385,7 +1444,7 @@ smt_astt smt_convt::convert_ast(const expr2tc &expr)
   case expr2t::concat_id:
   {
     if (int_encoding)
-      return convert_concat_int_mode(args[0], args[1], expr);
+      a = convert_concat_int_mode(args[0], args[1], expr);
     else
       a = mk_concat(args[0], args[1]);
     break;
@@ -1483,9 +1542,8 @@ smt_astt smt_convt::convert_ast(const expr2tc &expr)
   {
     const extract2t &ex = to_extract2t(expr);
     a = convert_ast(ex.from);
-    if (ex.from->type->get_width() == ex.upper - ex.lower + 1)
-      return a;
-    a = mk_extract(a, ex.upper, ex.lower);
+    if (ex.from->type->get_width() != ex.upper - ex.lower + 1)
+      a = mk_extract(a, ex.upper, ex.lower);
     break;
   }
   case expr2t::code_comma_id:
@@ -1564,11 +1622,8 @@ smt_astt smt_convt::convert_ast(const expr2tc &expr)
     abort();
   }
 
-  {
-    struct smt_cache_entryt entry = {expr, a, ctx_level};
-    std::lock_guard lock(smt_cache_mutex);
-    smt_cache.insert(entry);
-  }
+  struct smt_cache_entryt entry = {expr, a, ctx_level};
+  smt_cache.insert(entry);
   return a;
 }
 
@@ -2590,6 +2645,14 @@ type2tc smt_convt::get_flattened_array_subtype(const type2tc &type)
   return type_rec;
 }
 
+smt_convt::resultt smt_convt::dec_solve_refined()
+{
+  resultt result = dec_solve();
+  while (result == P_SATISFIABLE && fp_api->refine_approximations())
+    result = dec_solve();
+  return result;
+}
+
 void smt_convt::pre_solve()
 {
   // NB: always perform tuple constraint adding first, as it covers tuple
@@ -6,7 +6,6 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 #include <cstdint>
-#include <mutex>
 #include <solvers/prop/literal.h>
 #include <solvers/prop/pointer_logic.h>
 #include <irep2/irep2_utils.h>
@@ -181,6 +180,8 @@ public:
    *  Takes one expression, and converts it into the underlying SMT solver,
    *  returning a single smt_ast that represents the converted expressions
    *  value. The lifetime of the returned pointer is currently undefined.
+   *  Operands are converted bottom-up with an explicit stack, so deeply
+   *  nested expressions don't exhaust the native stack.
    *
    *  @param expr The expression to convert into the SMT solver
    *  @return The resulting handle to the SMT value. */
@@ -232,6 +233,27 @@ public:
    *  @return Result code of the call to the solver. */
   virtual resultt dec_solve() = 0;
 
+  /** Like dec_solve(), but while the satisfying assignment contradicts an
+   *  operation the floating-point API only approximated, encode those
+   *  operations exactly and solve again (see fp_refinement_convt). Use this
+   *  unless the formula is known to be exact.
+   *  @return Result code of the last call to the solver. */
+  resultt dec_solve_refined();
+
+  /** Ask a dec_solve() running in another thread to give up, in which case
+   *  it returns P_ERROR. Solvers may miss the request if their search hasn't
+   *  started yet, so it should be repeated until dec_solve() returns. By
+   *  default nothing happens and the solver runs to completion. */
+  virtual void interrupt()
+  {
+  }
+
+  /** Whether interrupt() makes a running dec_solve() give up. */
+  virtual bool can_interrupt() const
+  {
+    return false;
+  }
+
   void pre_solve();
 
   /** Get the satisfying assignment using the type.
@@ -624,6 +646,11 @@ public:
    *  conversion */
   smt_astt convert_terminal(const expr2tc &expr);
 
+  /** Convert one expression. convert_ast() calls this once the operands it
+   *  converts up-front are in the cache; any other operand is converted here
+   *  by calling back into convert_ast(). */
+  smt_astt convert_node(const expr2tc &expr);
+
   /** Flatten pointer arithmetic. When faced with an addition or subtraction
    *  between a pointer and some integer or other pointer, perform whatever
    *  multiplications or casting is requried to honor the C semantics of
@@ -849,10 +876,11 @@ public:
   /** Number of un-popped context pushes encountered so far. */
   unsigned int ctx_level;
 
-  /** A cache mapping expressions to converted SMT ASTs. */
+  /** A cache mapping expressions to converted SMT ASTs. It is not locked:
+   *  a converter must only be used by one thread at a time. Parallel solving
+   *  creates one per claim, and checks claims one by one where they share
+   *  a converter (see bmct::multi_property_check). */
   smt_cachet smt_cache;
-  /** A mutex lock for writing to the cache. */
-  std::mutex smt_cache_mutex;
   /** A cache of converted type2tc's to smt sorts */
   smt_sort_cachet sort_cache;
   /** Pointer_logict object, which contains some code for formatting how
@@ -2,6 +2,7 @@
 #include <solver_config.h>
 #include <solvers/smt/array_conv.h>
 #include <solvers/smt/fp/fp_conv.h>
+#include <solvers/smt/fp/fp_refinement.h>
 #include <solvers/smt/smt_array.h>
 #include <solvers/smt/tuple/smt_tuple_node.h>
 #include <solvers/smt/tuple/smt_tuple_sym.h>
@@ -136,6 +137,11 @@ pick_solver(std::string &solver_name, const optionst &options)
   abort();
 }
 
+bool is_solver_available(const std::string &solver_name)
+{
+  return esbmc_solvers.count(solver_name) != 0;
+}
+
 smt_convt *create_solver(
   std::string solver_name,
   const namespacet &ns,
@@ -177,7 +183,10 @@ smt_convt *create_solver(
   else
     ctx->set_array_iface(new array_convt(ctx));
 
-  if (fp_api == nullptr || fp_to_bv)
+  // Refinement approximates the bit-blasted encoding, so it implies fp2bv
+  if (options.get_bool_option("fp-refinement"))
+    ctx->set_fp_conv(new fp_refinement_convt(ctx));
+  else if (fp_api == nullptr || fp_to_bv)
     ctx->set_fp_conv(new fp_convt(ctx));
   else
     ctx->set_fp_conv(fp_api);
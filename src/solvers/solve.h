@@ -19,4 +19,7 @@ smt_convt *create_solver(
   const namespacet &ns,
   const optionst &options);
 
+/// Whether the solver called `solver_name` was built in
+bool is_solver_available(const std::string &solver_name);
+
 #endif
@@ -98,6 +98,11 @@ smt_convt::resultt yices_convt::dec_solve()
   return smt_convt::P_ERROR;
 }
 
+void yices_convt::interrupt()
+{
+  yices_stop_search(yices_ctx);
+}
+
 const std::string yices_convt::solver_text()
 {
   std::stringstream ss;
@@ -47,6 +47,11 @@ public:
   ~yices_convt() override;
 
   resultt dec_solve() override;
+  void interrupt() override;
+  bool can_interrupt() const override
+  {
+    return true;
+  }
   const std::string solver_text() override;
 
   void assert_ast(smt_astt a) override;
@@ -35,6 +35,11 @@ public:
   void push_ctx() override;
   void pop_ctx() override;
   smt_convt::resultt dec_solve() override;
+  void interrupt() override;
+  bool can_interrupt() const override
+  {
+    return true;
+  }
 
   bool get_bool(smt_astt a) override;
   BigInt get_bv(smt_astt a, bool is_signed) override;
@@ -1,3 +1,5 @@
+#include <fstream>
+#include <irep2/irep2_template_utils.h>
 #include <util/cache.h>
 #include <util/message.h>
 #include <utility>
@@ -27,3 +29,102 @@ bool assertion_cache::run(symex_target_equationt::SSA_stepst &eq)
     total);
   return true;
 }
+
+// First line of a cache file, bump whenever the key computation changes
+static const char claim_cache_header[] = "esbmc-claim-result-cache 1";
+
+claim_result_cachet::claim_result_cachet(std::string path, std::string salt)
+  : path(std::move(path)), salt(std::move(salt))
+{
+  std::ifstream in(this->path);
+  if (!in || in.peek() == std::ifstream::traits_type::eof())
+    return;
+
+  std::string line;
+  if (!std::getline(in, line) || line != claim_cache_header)
+  {
+    // Leave files we don't understand alone, e.g. from another version
+    log_warning("Ignoring claim result cache {}: unknown format", this->path);
+    read_only = true;
+    return;
+  }
+
+  has_header = true;
+
+  while (std::getline(in, line))
+    if (!line.empty())
+      proven.insert(line);
+}
+
+std::string claim_result_cachet::key(const symex_target_equationt &eq) const
+{
+  crypto_hash hash;
+  hash.ingest(salt.data(), salt.size());
+
+  // Only what convert_internal_step hands to the solver is part of the key,
+  // locations and comments are not
+  for (const auto &step : eq.SSA_steps)
+  {
+    if (step.ignore)
+      continue;
+
+    uint8_t type = step.type;
+    hash.ingest(&type, sizeof(type));
+    do_type_hash(step.guard, hash);
+
+    if (step.is_assert() || step.is_assume() || step.is_assignment())
+      do_type_hash(step.cond, hash);
+    else if (step.is_renumber())
+    {
+      do_type_hash(step.lhs, hash);
+      do_type_hash(step.rhs, hash);
+    }
+    else if (step.is_output())
+      for (const auto &arg : step.output_args)
+        do_type_hash(arg, hash);
+  }
+
+  hash.fin();
+  return hash.to_string();
+}
+
+bool claim_result_cachet::is_proven(const std::string &key) const
+{
+  std::lock_guard lock(mutex);
+  return proven.count(key) != 0;
+}
+
+void claim_result_cachet::record_proven(const std::string &key)
+{
+  std::lock_guard lock(mutex);
+  if (proven.insert(key).second)
+    added.push_back(key);
+}
+
+void claim_result_cachet::save()
+{
+  std::lock_guard lock(mutex);
+  if (added.empty() || read_only)
+    return;
+
+  std::ofstream out(path, std::ios::app);
+  if (!out)
+  {
+    log_warning("Failed to write the claim result cache {}", path);
+    return;
+  }
+
+  if (!has_header)
+    out << claim_cache_header << "\n";
+  has_header = true;
+  for (const auto &key : added)
+    out << key << "\n";
+
+  added.clear();
+}
+
+size_t claim_result_cachet::size() const
+{
+  std::lock_guard lock(mutex);
+  return proven.size();
+}
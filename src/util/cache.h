@@ -1,6 +1,9 @@
 #pragma once
 
+#include <mutex>
+#include <string>
 #include <unordered_set>
+#include <vector>
 
 #include <util/algorithms.h>
 #include <util/time_stopping.h>
@@ -38,3 +41,43 @@ private:
   BigInt hits = 0;
   BigInt total = 0;
 };
+
+/**
+ * @Brief On-disk record of claims whose sliced formula was proven
+ *        unsatisfiable, i.e. the claim holds. A later run producing a
+ *        byte-identical formula can report the claim as passed without
+ *        calling the solver.
+ *
+ *        Entries are keyed by a SHA-1 over everything the solver sees:
+ *        the non-ignored SSA steps of the claim plus a caller-provided salt
+ *        (tool version, solver and options). Only passing claims are stored,
+ *        failing ones still need the solver to build their counterexample.
+ */
+class claim_result_cachet
+{
+public:
+  /// Loads the entries stored in \p path, if it exists
+  claim_result_cachet(std::string path, std::string salt);
+
+  /// Key of the formula made of the non-ignored steps of \p eq
+  std::string key(const symex_target_equationt &eq) const;
+
+  bool is_proven(const std::string &key) const;
+  void record_proven(const std::string &key);
+
+  /// Appends the entries recorded since loading to the file
+  void save();
+
+  size_t size() const;
+
+protected:
+  const std::string path;
+  const std::string salt;
+
+  bool has_header = false;
+  bool read_only = false;
+
+  mutable std::mutex mutex;
+  std::unordered_set<std::string> proven;
+  std::vector<std::string> added;
+};
@@ -14,14 +14,8 @@ struct hash<assert_pair>
 {
   auto operator()(const assert_pair &p) const -> size_t
   {
-    const expr2tc &e1 = p.first;
-    const expr2tc &e2 = p.second;
-    crypto_hash h1, h2;
-    e1->hash(h1);
-    h1.fin();
-    e2->hash(h2);
-    h2.fin();
-    return h1.to_size_t() ^ h2.to_size_t();
+    // crc() is cached in the nodes, unlike a crypto_hash of the whole tree
+    return p.first.crc() ^ p.second.crc();
   }
 };
 } // namespace std
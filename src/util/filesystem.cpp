@@ -103,6 +103,30 @@ tmp_path file_operations::create_tmp_dir(const std::string &format)
     format)};
 }
 
+std::string file_operations::create_shared_dir(
+  const std::string &parent,
+  const std::string &name,
+  const std::function<void(const std::string &)> &fill)
+{
+  using namespace boost::filesystem;
+  path dir = path(parent) / name;
+  if (exists(dir))
+    return dir.string();
+
+  create_directories(parent);
+  path tmp = unique_path(dir.string() + ".%%%%-%%%%-%%%%");
+  create_directory(tmp);
+  fill(tmp.string());
+
+  // A run that got there first wins, its contents are the same
+  boost::system::error_code ec;
+  rename(tmp, dir, ec);
+  if (ec)
+    remove_all(tmp);
+
+  return dir.string();
+}
+
 const std::string
 file_operations::get_unique_tmp_path(const std::string &format)
 {
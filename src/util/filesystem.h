@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdio> /* FILE */
+#include <functional>
 #include <string>
 
 /**
@@ -101,6 +102,19 @@ tmp_file create_tmp_file(
 
 tmp_path create_tmp_dir(const std::string &format = "esbmc.%%%%-%%%%-%%%%");
 
+/**
+ * @brief Directory `parent`/`name` whose contents are created by `fill`.
+ *
+ * Unlike temporary directories, it is kept across runs: when it exists
+ * already it is returned as is, so `name` should identify its contents.
+ * `fill` works on a private directory that is then moved in place, so that
+ * concurrent runs never see it half-written.
+ */
+std::string create_shared_dir(
+  const std::string &parent,
+  const std::string &name,
+  const std::function<void(const std::string &)> &fill);
+
 /**
  *  @brief Creates all folders needed for a path
  * 
@@ -72,8 +72,7 @@ void irept::remove_ref(dt *old_data)
 
   assert(old_data->ref_count != 0);
 
-  old_data->ref_count--;
-  if (old_data->ref_count == 0)
+  if (--old_data->ref_count == 0)
   {
     delete old_data;
   }
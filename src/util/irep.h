@@ -1,6 +1,7 @@
 #ifndef CPROVER_IREP_H
 #define CPROVER_IREP_H
 
+#include <atomic>
 #include <cassert>
 #include <list>
 #include <map>
@@ -1288,7 +1289,8 @@ public:
   {
   public:
 #ifdef SHARING
-    unsigned ref_count;
+    // atomic, so that threads can share program data read-only
+    std::atomic<unsigned> ref_count;
 #endif
 
     dstring data;
@@ -1317,6 +1319,15 @@ public:
     dt() : ref_count(1)
     {
     }
+
+    dt(const dt &d)
+      : ref_count(1),
+        data(d.data),
+        named_sub(d.named_sub),
+        comments(d.comments),
+        sub(d.sub)
+    {
+    }
 #else
     dt()
     {
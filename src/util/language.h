@@ -5,6 +5,7 @@
 #include <set>
 #include <util/context.h>
 #include <util/namespace.h>
+#include <vector>
 
 enum class presentationt
 {
@@ -18,6 +19,17 @@ public:
   // parse file
   virtual bool parse(const std::string &path) = 0;
 
+  /* Parse several files, with the same result as calling parse() on each in
+   * turn. Languages whose files can be parsed independently may use up to
+   * `jobs` threads, 0 meaning one per hardware thread. */
+  virtual bool parse_files(const std::vector<std::string> &paths, unsigned)
+  {
+    for (const std::string &path : paths)
+      if (parse(path))
+        return true;
+    return false;
+  }
+
   // final adjustments, e.g., initialization and call to main()
   virtual bool final(contextt &)
   {
@@ -10,6 +10,7 @@
 #include <util/simplify_expr.h>
 #include <util/string_constant.h>
 #include <util/type_byte_size.h>
+#include <mutex>
 
 inline code_function_callt invoke_intrinsic(
   const std::string &name,
@@ -54,12 +55,14 @@ inline code_function_callt invoke_intrinsic(
 // Why is this a global? Because there are over three hundred call sites to
 // migrate_expr, and it's a huge task to fix them all up to pass a namespace
 // down.
-const namespacet *migrate_namespace_lookup = nullptr;
+thread_local const namespacet *migrate_namespace_lookup = nullptr;
 
 static std::map<irep_idt, BigInt> bin2int_map_signed, bin2int_map_unsigned;
+static std::mutex bin2int_mutex;
 
 const BigInt &binary2bigint(irep_idt binary, bool is_signed)
 {
+  std::lock_guard lock(bin2int_mutex);
   std::map<irep_idt, BigInt> &ref =
     (is_signed) ? bin2int_map_signed : bin2int_map_unsigned;
 
@@ -9,9 +9,10 @@
 #include <util/std_expr.h>
 #include <util/std_types.h>
 
-// Don't ask
+// Don't ask. Per thread: threads working on their own symbol table, like
+// the parallel k-induction workers, point it at their own namespace.
 class namespacet;
-extern const namespacet *migrate_namespace_lookup;
+extern thread_local const namespacet *migrate_namespace_lookup;
 
 type2tc migrate_type(const typet &type);
 void migrate_expr(const exprt &expr, expr2tc &new_expr);
@@ -0,0 +1,429 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Hash map with structural sharing (a hash array mapped trie).
+ *
+ * Copying a map is O(1): both copies share every node until one of them is
+ * modified, at which point only the nodes on the path to the modified entry
+ * are copied. This makes snapshots of large maps, e.g. the symex state at a
+ * branch, cheap, and lets two related maps be compared by only looking at
+ * the subtrees they don't share (see for_each_unshared).
+ *
+ * The interface follows std::unordered_map for lookups and iteration, which
+ * are read-only. Entries are modified through operator[], insert() and
+ * find_writable(); the references they return stay valid until the next
+ * modification of the map, and must not be used once the map was copied.
+ */
+template <
+  typename Key,
+  typename T,
+  typename Hash = std::hash<Key>,
+  typename KeyEqual = std::equal_to<Key>>
+class persistent_mapt
+{
+public:
+  typedef Key key_type;
+  typedef T mapped_type;
+  typedef std::pair<Key, T> value_type;
+
+private:
+  static constexpr unsigned bits_per_level = 5;
+  static constexpr size_t level_mask = (size_t(1) << bits_per_level) - 1;
+  static constexpr unsigned max_depth =
+    (sizeof(size_t) * 8 + bits_per_level - 1) / bits_per_level;
+
+  struct nodet;
+  typedef std::shared_ptr<nodet> node_ptrt;
+
+  /* A node is either a branch, holding up to 32 children indexed by the
+   * next bits of the hash, or a leaf, holding the entries whose hashes are
+   * all equal to `hash`. Leaves are never empty, branches other than the
+   * root never have a single leaf as their only child. */
+  struct nodet
+  {
+    uint32_t bitmap = 0;
+    std::vector<node_ptrt> children;
+
+    size_t hash = 0;
+    std::vector<value_type> entries;
+
+    bool is_leaf() const
+    {
+      return !entries.empty();
+    }
+  };
+
+  static unsigned slot(size_t hash, unsigned depth)
+  {
+    return (hash >> (bits_per_level * depth)) & level_mask;
+  }
+
+  static uint32_t bit(unsigned slot)
+  {
+    return uint32_t(1) << slot;
+  }
+
+  static unsigned popcount(uint32_t x)
+  {
+    x = x - ((x >> 1) & 0x55555555);
+    x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+    x = (x + (x >> 4)) & 0x0F0F0F0F;
+    return (x * 0x01010101) >> 24;
+  }
+
+  /// Position of `slot` in the compressed children vector
+  static unsigned index(uint32_t bitmap, unsigned slot)
+  {
+    return popcount(bitmap & (bit(slot) - 1));
+  }
+
+  /// Makes `*p` exclusively owned by this map, copying it if shared
+  static nodet &own(node_ptrt &p)
+  {
+    if (p.use_count() != 1)
+      p = std::make_shared<nodet>(*p);
+    return *p;
+  }
+
+public:
+  class const_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename persistent_mapt::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type *pointer;
+    typedef const value_type &reference;
+
+    const_iterator() = default;
+
+    reference operator*() const
+    {
+      const framet &top = stack[depth - 1];
+      return top.node->entries[top.idx];
+    }
+
+    pointer operator->() const
+    {
+      return &**this;
+    }
+
+    const_iterator &operator++()
+    {
+      assert(depth > 0);
+      framet *top = &stack[depth - 1];
+      if (++top->idx < top->node->entries.size())
+        return *this;
+
+      // Leaf exhausted, move to the next child of the closest branch
+      while (--depth > 0)
+      {
+        top = &stack[depth - 1];
+        if (++top->idx < top->node->children.size())
+        {
+          descend(top->node->children[top->idx].get());
+          break;
+        }
+      }
+
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const
+    {
+      if (depth == 0 || other.depth == 0)
+        return depth == other.depth;
+
+      const framet &a = stack[depth - 1];
+      const framet &b = other.stack[other.depth - 1];
+      return a.node == b.node && a.idx == b.idx;
+    }
+
+    bool operator!=(const const_iterator &other) const
+    {
+      return !(*this == other);
+    }
+
+  private:
+    friend class persistent_mapt;
+
+    struct framet
+    {
+      const nodet *node;
+      size_t idx;
+    };
+
+    // Path from the root to the current leaf, a branch frame's idx is the
+    // child being visited, the leaf frame's one the entry
+    std::array<framet, max_depth + 1> stack;
+    unsigned depth = 0;
+
+    void push(const nodet *node, size_t idx)
+    {
+      assert(depth < stack.size());
+      stack[depth++] = {node, idx};
+    }
+
+    /// Moves to the first entry below `node`
+    void descend(const nodet *node)
+    {
+      while (!node->is_leaf())
+      {
+        assert(!node->children.empty());
+        push(node, 0);
+        node = node->children.front().get();
+      }
+      push(node, 0);
+    }
+  };
+
+  persistent_mapt() = default;
+
+  const_iterator begin() const
+  {
+    const_iterator it;
+    if (n_entries != 0)
+      it.descend(root.get());
+    return it;
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator();
+  }
+
+  size_t size() const
+  {
+    return n_entries;
+  }
+
+  bool empty() const
+  {
+    return n_entries == 0;
+  }
+
+  void clear()
+  {
+    root.reset();
+    n_entries = 0;
+  }
+
+  const_iterator find(const Key &key) const
+  {
+    const_iterator it;
+    size_t hash = Hash{}(key);
+    const nodet *n = root.get();
+    for (unsigned depth = 0; n != nullptr; ++depth)
+    {
+      if (n->is_leaf())
+      {
+        if (n->hash != hash)
+          break;
+
+        for (size_t i = 0; i < n->entries.size(); i++)
+          if (KeyEqual{}(n->entries[i].first, key))
+          {
+            it.push(n, i);
+            return it;
+          }
+
+        break;
+      }
+
+      unsigned s = slot(hash, depth);
+      if (!(n->bitmap & bit(s)))
+        break;
+
+      unsigned i = index(n->bitmap, s);
+      it.push(n, i);
+      n = n->children[i].get();
+    }
+
+    return end();
+  }
+
+  size_t count(const Key &key) const
+  {
+    return find(key) != end();
+  }
+
+  /// Entry for `key`, inserting a default constructed value if missing
+  T &operator[](const Key &key)
+  {
+    return *emplace(key, [] { return T(); }).first;
+  }
+
+  /**
+   * Inserts `value` for `key` unless the key is present already. Returns the
+   * stored value and whether it was inserted.
+   */
+  std::pair<T *, bool> insert(const Key &key, const T &value)
+  {
+    return emplace(key, [&value] { return value; });
+  }
+
+  /// Writable entry for `key`, or nullptr. Misses don't unshare any node.
+  T *find_writable(const Key &key)
+  {
+    if (find(key) == end())
+      return nullptr;
+    return &(*this)[key];
+  }
+
+  size_t erase(const Key &key)
+  {
+    if (find(key) == end())
+      return 0;
+
+    if (erase_rec(root, Hash{}(key), key, 0))
+      root.reset();
+    --n_entries;
+    return 1;
+  }
+
+  /**
+   * Calls `f(entry)` on every entry of this map that may differ from, or be
+   * missing in, `base`. Subtrees shared by both maps are skipped, so this is
+   * proportional to the changes made since one map was copied from the
+   * other. Entries of `base` missing in this map are not visited.
+   */
+  template <typename F>
+  void for_each_unshared(const persistent_mapt &base, F &&f) const
+  {
+    unshared_rec(root.get(), base.root.get(), f);
+  }
+
+private:
+  node_ptrt root;
+  size_t n_entries = 0;
+
+  template <typename MakeValue>
+  std::pair<T *, bool> emplace(const Key &key, MakeValue &&make_value)
+  {
+    size_t hash = Hash{}(key);
+    if (!root)
+      root = std::make_shared<nodet>();
+
+    node_ptrt *p = &root;
+    unsigned depth = 0;
+    while (true)
+    {
+      if ((*p)->is_leaf() && (*p)->hash != hash)
+      {
+        // Push the leaf one level down; it can stay shared
+        auto branch = std::make_shared<nodet>();
+        branch->bitmap = bit(slot((*p)->hash, depth));
+        branch->children.push_back(std::move(*p));
+        *p = std::move(branch);
+        continue;
+      }
+
+      nodet &n = own(*p);
+      if (n.is_leaf())
+      {
+        for (auto &e : n.entries)
+          if (KeyEqual{}(e.first, key))
+            return {&e.second, false};
+
+        n.entries.emplace_back(key, make_value());
+        ++n_entries;
+        return {&n.entries.back().second, true};
+      }
+
+      unsigned s = slot(hash, depth);
+      unsigned i = index(n.bitmap, s);
+      if (!(n.bitmap & bit(s)))
+      {
+        auto leaf = std::make_shared<nodet>();
+        leaf->hash = hash;
+        leaf->entries.emplace_back(key, make_value());
+        n.bitmap |= bit(s);
+        n.children.insert(n.children.begin() + i, leaf);
+        ++n_entries;
+        return {&leaf->entries.back().second, true};
+      }
+
+      p = &n.children[i];
+      ++depth;
+    }
+  }
+
+  /// Returns whether `p` became empty and has to be dropped by the caller
+  static bool
+  erase_rec(node_ptrt &p, size_t hash, const Key &key, unsigned depth)
+  {
+    nodet &n = own(p);
+    if (n.is_leaf())
+    {
+      for (auto it = n.entries.begin(); it != n.entries.end(); ++it)
+        if (KeyEqual{}(it->first, key))
+        {
+          n.entries.erase(it);
+          break;
+        }
+
+      return n.entries.empty();
+    }
+
+    unsigned s = slot(hash, depth);
+    unsigned i = index(n.bitmap, s);
+    if (erase_rec(n.children[i], hash, key, depth + 1))
+    {
+      n.children.erase(n.children.begin() + i);
+      n.bitmap &= ~bit(s);
+    }
+
+    // Keep the trie canonical: a lone leaf moves up in place of its branch
+    if (n.children.size() == 1 && n.children.front()->is_leaf())
+    {
+      node_ptrt leaf = n.children.front();
+      p = std::move(leaf);
+      return false;
+    }
+
+    return n.children.empty();
+  }
+
+  template <typename F>
+  static void unshared_rec(const nodet *n, const nodet *base, F &f)
+  {
+    if (n == base || n == nullptr)
+      return;
+
+    if (n->is_leaf())
+    {
+      for (const auto &e : n->entries)
+        f(e);
+      return;
+    }
+
+    bool base_is_branch = base != nullptr && !base->is_leaf();
+    for (unsigned s = 0, i = 0; i < n->children.size(); s++)
+    {
+      if (!(n->bitmap & bit(s)))
+        continue;
+
+      const nodet *b = nullptr;
+      if (base_is_branch && (base->bitmap & bit(s)))
+        b = base->children[index(base->bitmap, s)].get();
+
+      unshared_rec(n->children[i++].get(), b, f);
+    }
+  }
+};
@@ -1,5 +1,6 @@
 #include <cassert>
 #include <cstring>
+#include <mutex>
 
 #include <util/string_container.h>
 
@@ -15,70 +16,59 @@ bool string_ptrt::operator==(const string_ptrt &other) const
   return len == 0 || memcmp(s, other.s, len) == 0;
 }
 
-unsigned string_containert::get(const char *s)
+string_containert::~string_containert()
 {
-  string_ptrt string_ptr(s);
-
-  {
-    std::shared_lock lock(string_container_mutex);
-    hash_tablet::iterator it = hash_table.find(string_ptr);
+  for (auto &segment : segments)
+    delete[] segment.load(std::memory_order_relaxed);
+}
 
-    if (it != hash_table.end())
-      return it->second;
-  }
+string_containert::slott &string_containert::slot(size_t no)
+{
+  std::atomic<slott *> &segment = segments.at(no >> segment_bits);
+  slott *s = segment.load(std::memory_order_acquire);
 
-  std::unique_lock lock(string_container_mutex);
-  //Recheck after acquiring sole lock
-  hash_tablet::iterator it = hash_table.find(string_ptr);
-  if (it != hash_table.end())
+  if (s == nullptr)
   {
-    return it->second;
+    // Several shards may race to allocate the same segment, only one wins
+    slott *fresh = new slott[segment_size]();
+    if (segment.compare_exchange_strong(
+          s, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+      s = fresh;
+    else
+      delete[] fresh;
   }
 
-  size_t r = hash_table.size();
-
-  // these are stable
-  string_list.emplace_back(s);
-  string_ptrt result(string_list.back());
-
-  hash_table[result] = r;
-
-  // these are not
-  string_vector.push_back(&string_list.back());
-
-  return r;
+  return s[no & (segment_size - 1)];
 }
 
-unsigned string_containert::get(const std::string &s)
+unsigned string_containert::get(const string_ptrt &s)
 {
-  string_ptrt string_ptr(s);
+  size_t h = string_ptr_hash{}(s);
+  // The low bits select the bucket inside the shard's table, use the high
+  // ones to pick the shard
+  shardt &shard = shards[(h >> 24) % n_shards];
 
   {
-    std::shared_lock lock(string_container_mutex);
-    hash_tablet::iterator it = hash_table.find(string_ptr);
+    std::shared_lock lock(shard.mutex);
+    hash_tablet::const_iterator it = shard.hash_table.find(s);
 
-    if (it != hash_table.end())
+    if (it != shard.hash_table.end())
       return it->second;
   }
 
-  std::unique_lock lock(string_container_mutex);
+  std::unique_lock lock(shard.mutex);
   //Recheck after acquiring sole lock
-  hash_tablet::iterator it = hash_table.find(string_ptr);
-  if (it != hash_table.end())
-  {
+  hash_tablet::const_iterator it = shard.hash_table.find(s);
+  if (it != shard.hash_table.end())
     return it->second;
-  }
-
-  size_t r = hash_table.size();
-
-  // these are stable
-  string_list.push_back(s);
-  string_ptrt result(string_list.back());
 
-  hash_table[result] = r;
+  shard.string_list.emplace_back(s.s, s.len);
+  const std::string &stored = shard.string_list.back();
 
-  // these are not
-  string_vector.push_back(&string_list.back());
+  unsigned r = next_id.fetch_add(1, std::memory_order_relaxed);
+  // Publish the string before the id can escape this function
+  slot(r).store(&stored, std::memory_order_release);
+  shard.hash_table.emplace(string_ptrt(stored), r);
 
   return r;
 }
@@ -1,12 +1,14 @@
 #ifndef STRING_CONTAINER_H
 #define STRING_CONTAINER_H
 
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <list>
 #include <shared_mutex>
 #include <unordered_map>
 #include <string>
-#include <vector>
+#include <string_view>
 
 struct string_ptrt
 {
@@ -32,58 +34,102 @@ class string_ptr_hash
 public:
   size_t operator()(const string_ptrt s) const
   {
-    return std::hash<std::string>{}(s.s);
+    return std::hash<std::string_view>{}(std::string_view(s.s, s.len));
   }
 };
 
+/**
+ * @brief Global pool of interned strings, indexed by dense unsigned ids.
+ *
+ * Interning is spread over a fixed number of shards, each guarded by its own
+ * lock, so threads interning unrelated strings rarely contend. Ids are handed
+ * out by a single atomic counter and the reverse mapping (id to string) lives
+ * in a segmented table that is never relocated, which makes `c_str()` and
+ * `get_string()` lock-free.
+ */
 class string_containert
 {
 public:
   unsigned operator[](const char *s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   unsigned operator[](const std::string &s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   string_containert()
   {
     // allocate empty string -- this gets index 0
-    get("");
+    get(string_ptrt(""));
   }
-  ~string_containert() = default;
+  ~string_containert();
+
+  string_containert(const string_containert &) = delete;
+  string_containert &operator=(const string_containert &) = delete;
 
   // the pointer is guaranteed to be stable
   const char *c_str(size_t no) const
   {
-    assert(no < string_vector.size());
-    return string_vector[no]->c_str();
+    return lookup(no).c_str();
   }
 
   // the reference is guaranteed to be stable
   const std::string &get_string(size_t no) const
   {
-    std::shared_lock lock(string_container_mutex);
-    assert(no < string_vector.size());
-    return *string_vector[no];
+    return lookup(no);
+  }
+
+  /// Number of strings interned so far
+  size_t size() const
+  {
+    return next_id.load(std::memory_order_relaxed);
   }
 
 protected:
-  typedef std::unordered_map<string_ptrt, size_t, string_ptr_hash> hash_tablet;
-  hash_tablet hash_table;
-  mutable std::shared_mutex string_container_mutex;
+  typedef std::unordered_map<string_ptrt, unsigned, string_ptr_hash>
+    hash_tablet;
+  typedef std::list<std::string> string_listt;
 
-  unsigned get(const char *s);
-  unsigned get(const std::string &s);
+  struct shardt
+  {
+    mutable std::shared_mutex mutex;
+    hash_tablet hash_table;
+    // these are stable
+    string_listt string_list;
+  };
 
-  typedef std::list<std::string> string_listt;
-  string_listt string_list;
+  static constexpr size_t n_shards = 64;
+  std::array<shardt, n_shards> shards;
 
-  typedef std::vector<std::string *> string_vectort;
-  string_vectort string_vector;
+  unsigned get(const string_ptrt &s);
+
+  // The id -> string table is split into segments of fixed size. Segments
+  // are allocated on first use and never move, so readers only need an
+  // acquire load on the slot the writer published with a release store.
+  typedef std::atomic<const std::string *> slott;
+  static constexpr size_t segment_bits = 16;
+  static constexpr size_t segment_size = size_t(1) << segment_bits;
+  static constexpr size_t n_segments = size_t(1) << 12;
+
+  std::atomic<unsigned> next_id{0};
+  std::array<std::atomic<slott *>, n_segments> segments{};
+
+  slott &slot(size_t no);
+
+  const std::string &lookup(size_t no) const
+  {
+    assert(no < size());
+    slott *segment =
+      segments[no >> segment_bits].load(std::memory_order_acquire);
+    assert(segment != nullptr);
+    const std::string *s =
+      segment[no & (segment_size - 1)].load(std::memory_order_acquire);
+    assert(s != nullptr);
+    return *s;
+  }
 };
 
 inline string_containert &get_string_container()
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// See util/migrate.h
+class namespacet;
+extern thread_local const namespacet *migrate_namespace_lookup;
+
+/**
+ * @brief Fixed-size pool of worker threads that drains a list of jobs.
+ *
+ * Workers claim jobs through a shared cursor, so a job is picked up as soon
+ * as any worker becomes idle and the machine stays saturated until the list
+ * runs dry. Since jobs are claimed in list order, callers control scheduling
+ * by sorting the list beforehand (e.g. most expensive first).
+ *
+ * At most `size()` jobs are alive at any time, regardless of the number of
+ * jobs in the list.
+ */
+class bounded_worker_poolt
+{
+public:
+  /// @param workers number of threads, 0 means one per hardware thread
+  explicit bounded_worker_poolt(unsigned workers = 0)
+    : workers(workers ? workers : default_workers())
+  {
+  }
+
+  static unsigned default_workers()
+  {
+    unsigned n = std::thread::hardware_concurrency();
+    return n ? n : 1;
+  }
+
+  unsigned size() const
+  {
+    return workers;
+  }
+
+  /**
+   * @brief Runs `job` over every element of `jobs` and waits for all of them
+   *
+   * The calling thread takes part as one of the workers. If a job throws,
+   * the remaining jobs are cancelled and the first exception is rethrown
+   * once every worker has stopped. Workers look symbols up in the caller's
+   * migrate_namespace_lookup.
+   */
+  template <typename T, typename F>
+  void run(const std::vector<T> &jobs, F &&job)
+  {
+    next = 0;
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    const namespacet *ns = migrate_namespace_lookup;
+
+    auto worker = [&]() {
+      migrate_namespace_lookup = ns;
+      while (!cancelled())
+      {
+        size_t idx = next.fetch_add(1, std::memory_order_relaxed);
+        if (idx >= jobs.size())
+          return;
+
+        try
+        {
+          job(jobs[idx]);
+        }
+        catch (...)
+        {
+          std::lock_guard lock(error_mutex);
+          if (!error)
+            error = std::current_exception();
+          cancel();
+        }
+      }
+    };
+
+    size_t n_threads = std::min<size_t>(workers, jobs.size());
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < n_threads; t++)
+      threads.emplace_back(worker);
+
+    worker();
+
+    for (auto &t : threads)
+      t.join();
+
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+  /// Stops workers from claiming new jobs, running jobs are left to finish
+  void cancel()
+  {
+    stop = true;
+  }
+
+  bool cancelled() const
+  {
+    return stop;
+  }
+
+private:
+  const unsigned workers;
+  std::atomic<size_t> next{0};
+  std::atomic<bool> stop{false};
+};
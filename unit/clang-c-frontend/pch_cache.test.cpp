@@ -0,0 +1,67 @@
+/// \file Tests for the precompiled preludes kept with --pch-cache
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include "../testing-utils/goto_factory.h"
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <util/config.h>
+
+namespace
+{
+/// Paths of the precompiled headers in `dir`
+std::vector<boost::filesystem::path> pchs(const boost::filesystem::path &dir)
+{
+  std::vector<boost::filesystem::path> result;
+  for (const auto &entry : boost::filesystem::directory_iterator(dir))
+    if (entry.path().extension() == ".pch")
+      result.push_back(entry.path());
+  return result;
+}
+
+/// Parses and converts `path` as esbmc would with --pch-cache `dir`
+bool convert(const std::string &path, const std::string &dir)
+{
+  cmdlinet cmdline = goto_factory::get_default_cmdline(path);
+  config.set(cmdline);
+  config.ansi_c.set_data_model(configt::LP64);
+  config.options = goto_factory::get_default_options(cmdline);
+  config.options.set_option("pch-cache", dir);
+
+  program P;
+  if (P.parse(cmdline) || P.typecheck() || P.final())
+    return false;
+  return P.context.find_symbol("c:@F@main") != nullptr;
+}
+} // namespace
+
+SCENARIO("--pch-cache reuses the precompiled prelude", "[pch-cache]")
+{
+  boost::filesystem::path tmp = boost::filesystem::temp_directory_path() /
+                                boost::filesystem::unique_path();
+  boost::filesystem::create_directories(tmp);
+  const std::string source = (tmp / "main.c").string();
+  const boost::filesystem::path cache = tmp / "cache";
+  // int64_t is only declared by the precompiled system header
+  std::ofstream(source) << "#include <stdint.h>\n"
+                           "int main() { int64_t x = 1; return x; }\n";
+
+  GIVEN("A first run against an empty cache")
+  {
+    REQUIRE(convert(source, cache.string()));
+    REQUIRE(pchs(cache).size() == 1);
+    const boost::filesystem::path pch = pchs(cache).front();
+    // Backdated, so that a rebuilt header would be told apart
+    const std::time_t built = boost::filesystem::last_write_time(pch) - 3600;
+    boost::filesystem::last_write_time(pch, built);
+
+    THEN("A second run loads the precompiled header instead of building it")
+    {
+      REQUIRE(convert(source, cache.string()));
+      REQUIRE(pchs(cache) == std::vector<boost::filesystem::path>{pch});
+      REQUIRE(boost::filesystem::last_write_time(pch) == built);
+    }
+  }
+
+  boost::filesystem::remove_all(tmp);
+}
@@ -0,0 +1,128 @@
+/// \file Tests for the cache of converted translation units, see --tu-cache
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <boost/filesystem.hpp>
+#include <clang-c-frontend/tu_cache.h>
+#include <fstream>
+#include <util/c_types.h>
+#include <util/config.h>
+
+namespace
+{
+/// A fresh directory, removed with the object
+struct temporary_dirt
+{
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+                                 boost::filesystem::unique_path();
+
+  temporary_dirt()
+  {
+    boost::filesystem::create_directories(path);
+  }
+
+  ~temporary_dirt()
+  {
+    boost::filesystem::remove_all(path);
+  }
+
+  std::string file(const std::string &name, const std::string &contents)
+  {
+    std::string p = (path / name).string();
+    std::ofstream(p) << contents;
+    return p;
+  }
+};
+
+contextt converted(const std::string &id)
+{
+  contextt ctx;
+  symbolt s;
+  s.id = id;
+  s.name = id;
+  s.type = int_type();
+  ctx.add(s);
+  return ctx;
+}
+} // namespace
+
+SCENARIO("tu_cachet reuses the entries of unchanged files", "[tu-cache]")
+{
+  temporary_dirt tmp;
+  const std::string source = tmp.file("main.c", "#include \"h.h\"\n");
+  const std::string header = tmp.file("h.h", "int x;\n");
+  tu_cachet cache((tmp.path / "cache").string());
+  const std::vector<std::string> args = {"-O0"};
+
+  const std::string key = cache.key(source, args, "salt");
+  REQUIRE_FALSE(key.empty());
+  REQUIRE(cache.key(source, args, "salt") == key);
+
+  GIVEN("An empty cache")
+  {
+    contextt ctx;
+    THEN("Nothing is found")
+    {
+      REQUIRE_FALSE(cache.lookup(key, ctx));
+      REQUIRE(ctx.size() == 0);
+    }
+  }
+
+  GIVEN("A stored entry")
+  {
+    cache.store(key, {source, header}, converted("c:@x"));
+
+    THEN("A later lookup finds its symbols")
+    {
+      contextt ctx;
+      REQUIRE(cache.lookup(key, ctx));
+      REQUIRE(ctx.find_symbol("c:@x") != nullptr);
+    }
+
+    THEN("Other arguments, salts or sources have other keys")
+    {
+      REQUIRE(cache.key(source, {"-O2"}, "salt") != key);
+      REQUIRE(cache.key(source, args, "other salt") != key);
+      tmp.file("main.c", "#include \"h.h\"\nint y;\n");
+      REQUIRE(cache.key(source, args, "salt") != key);
+    }
+
+    THEN("Changing a file it was read from invalidates it")
+    {
+      tmp.file("h.h", "int x, y;\n");
+      contextt ctx;
+      REQUIRE_FALSE(cache.lookup(key, ctx));
+      REQUIRE(ctx.size() == 0);
+    }
+
+    THEN("Removing a file it was read from invalidates it")
+    {
+      boost::filesystem::remove(header);
+      contextt ctx;
+      REQUIRE_FALSE(cache.lookup(key, ctx));
+    }
+
+    THEN("An entry written by another version is stale")
+    {
+      std::string deps = (tmp.path / "cache" / (key + ".deps")).string();
+      std::ofstream(deps) << "esbmc-tu-cache 0\n";
+      contextt ctx;
+      REQUIRE_FALSE(cache.lookup(key, ctx));
+    }
+  }
+
+  GIVEN("An entry declaring __ESBMC_no_slice variables")
+  {
+    config.no_slice_names = {"c:@x"};
+    cache.store(key, {source}, converted("c:@x"));
+    config.no_slice_names.clear();
+
+    THEN("A lookup declares them again")
+    {
+      contextt ctx;
+      REQUIRE(cache.lookup(key, ctx));
+      REQUIRE(config.no_slice_names.count("c:@x"));
+      config.no_slice_names.clear();
+    }
+  }
+}
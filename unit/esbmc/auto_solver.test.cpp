@@ -0,0 +1,104 @@
+/// \file Tests for the rules of --auto-solver and the formula metrics
+/// they are matched against
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <esbmc/auto_solver.h>
+#include <irep2/irep2_utils.h>
+#include <string>
+#include <util/c_types.h>
+
+namespace
+{
+/// Exposes the parser of a single rule
+class test_auto_solvert : public auto_solvert
+{
+public:
+  using auto_solvert::parse;
+};
+
+std::string parse_error(const std::string &line)
+{
+  auto_solvert::rulet rule;
+  return test_auto_solvert::parse(line, rule);
+}
+} // namespace
+
+TEST_CASE("auto_solvert parses rules", "[esbmc]")
+{
+  auto_solvert::rulet rule;
+  REQUIRE(
+    test_auto_solvert::parse(
+      "float, !nonlinear, nodes >= 10 : solver=z3 fp=bv", rule) == "");
+  REQUIRE(rule.solver == "z3");
+  REQUIRE(rule.options.get_bool_option("fp2bv"));
+  REQUIRE(rule.conditions.size() == 3);
+  REQUIRE(rule.conditions[0].is_feature);
+  REQUIRE_FALSE(rule.conditions[0].negated);
+  REQUIRE(rule.conditions[1].negated);
+  REQUIRE(rule.conditions[2].metric == "nodes");
+  REQUIRE(rule.conditions[2].op == ">=");
+  REQUIRE(rule.conditions[2].value == 10);
+
+  ssa_features f;
+  f.features.insert(SSA_FEATURES::FLOATING_POINT);
+  f.nodes = 10;
+  for (const auto_solvert::conditiont &c : rule.conditions)
+    REQUIRE(c.holds(f));
+  f.nodes = 9;
+  REQUIRE_FALSE(rule.conditions[2].holds(f));
+  f.features.insert(SSA_FEATURES::NON_LINEAR);
+  REQUIRE_FALSE(rule.conditions[1].holds(f));
+}
+
+TEST_CASE("auto_solvert rejects malformed rules", "[esbmc]")
+{
+  REQUIRE(
+    parse_error("float solver=z3") ==
+    "expected ':' between the conditions and the settings");
+  REQUIRE(parse_error("float, : solver=z3") == "empty condition");
+  REQUIRE(parse_error("floats : solver=z3") == "unknown feature 'floats'");
+  REQUIRE(parse_error("size > 3 : solver=z3") == "unknown metric 'size'");
+  REQUIRE(parse_error("nodes => 3 : solver=z3") == "unknown comparison '=>'");
+  REQUIRE(
+    parse_error("nodes >= many : solver=z3") == "expected a number after '>='");
+  REQUIRE(
+    parse_error("* : solver=z3 colour=red") == "unknown setting 'colour=red'");
+  REQUIRE(parse_error("float : fp=native") == "the rule picks no solver");
+}
+
+TEST_CASE("ssa_features counts shared expressions once", "[esbmc]")
+{
+  // x_{i+1} = c_i ? x_i + 1 : x_i, which has 2^n paths through it
+  const size_t n = 10000;
+  const type2tc t = get_uint_type(32);
+  std::vector<expr2tc> levels = {symbol2tc(t, "x")};
+  for (size_t i = 0; i < n; i++)
+  {
+    const expr2tc &x = levels.back();
+    expr2tc c = symbol2tc(get_bool_type(), "c" + std::to_string(i));
+    levels.push_back(if2tc(t, c, add2tc(t, x, gen_one(t)), x));
+  }
+
+  symex_target_equationt::SSA_stepst steps(2);
+  steps.front().cond = equality2tc(levels.back(), gen_zero(t));
+  steps.back().cond = steps.front().cond;
+  steps.back().ignore = true;
+
+  ssa_features f;
+  f.collect(steps);
+  REQUIRE(f.steps == 1);
+  // Per level an if, its condition, an addition and a one, then the
+  // equality, its zero and the first x
+  REQUIRE(f.nodes == 4 * n + 3);
+  REQUIRE(f.depth == 2 * n + 2);
+
+  // --ssa-features-dump looks at every step
+  f.collect(steps, false);
+  REQUIRE(f.steps == 2);
+  REQUIRE(f.nodes == 4 * n + 3);
+
+  steps.clear();
+  while (!levels.empty())
+    levels.pop_back();
+}
@@ -0,0 +1,224 @@
+/// \file Tests for the memory-mappable goto-binary format
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <goto-programs/goto_binary_index.h>
+#include <goto-programs/goto_binary_reader.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
+#include <sstream>
+#include <irep2/irep2_expr.h>
+#include <util/c_types.h>
+#include <util/context.h>
+#include <util/migrate.h>
+#include <util/namespace.h>
+
+namespace
+{
+symbolt make_symbol(const std::string &id, const std::string &function)
+{
+  symbolt s;
+  s.id = id;
+  s.name = id;
+  s.type = int_type();
+  s.value = exprt("constant", s.type);
+  s.value.value(id);
+  s.location.set_function(function);
+  return s;
+}
+
+std::string write(const contextt &ctx)
+{
+  goto_functionst functions;
+  std::ostringstream out;
+  REQUIRE_FALSE(write_goto_binary(out, ctx, functions));
+  return out.str();
+}
+
+/// Adds function `id` to `ctx` and `functions`, with a body calling `calls`
+void add_function(
+  const std::string &id,
+  const std::vector<std::string> &calls,
+  contextt &ctx,
+  goto_functionst &functions)
+{
+  symbolt s;
+  s.id = id;
+  s.name = id;
+  s.type = code_typet(code_typet::argumentst(), empty_typet());
+  ctx.add(s);
+
+  goto_functiont &f = functions.function_map[id];
+  f.type = to_code_type(s.type);
+  for (const std::string &callee : calls)
+  {
+    goto_programt::targett t = f.body.add_instruction(FUNCTION_CALL);
+    t->code = code_function_call2tc(
+      expr2tc(), symbol2tc(get_empty_type(), callee), std::vector<expr2tc>());
+    t->function = id;
+  }
+  f.body.add_instruction(END_FUNCTION)->function = id;
+  f.body_available = true;
+}
+
+std::string write_file(const contextt &ctx, goto_functionst &functions)
+{
+  std::ostringstream out;
+  REQUIRE_FALSE(write_goto_binary(out, ctx, functions));
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+                                 boost::filesystem::unique_path();
+  std::ofstream(path.string(), std::ios::binary) << out.str();
+  return path.string();
+}
+} // namespace
+
+TEST_CASE(
+  "Mapped goto-binary gives access to single symbols",
+  "[goto-binary]")
+{
+  contextt ctx;
+  for (unsigned i = 0; i < 50; i++)
+    ctx.add(make_symbol("s" + std::to_string(i), i % 2 ? "f" : "g"));
+
+  std::string data = write(ctx);
+
+  goto_binary_indext index;
+  REQUIRE_FALSE(index.load(data.data(), data.size()));
+  REQUIRE(index.symbols().size() == 50);
+  REQUIRE(index.functions().empty());
+  REQUIRE(index.find_symbol("missing") == nullptr);
+
+  // Entries decode independently of each other, in any order
+  for (unsigned i = 50; i-- > 0;)
+  {
+    std::string id = "s" + std::to_string(i);
+    const goto_binary_indext::entryt *e = index.find_symbol(id);
+    REQUIRE(e != nullptr);
+    REQUIRE(e->function == (i % 2 ? "f" : "g"));
+
+    symbolt s;
+    index.read_symbol(*e, s);
+    REQUIRE(s.id == id);
+    REQUIRE(s.value.value() == id);
+    REQUIRE(s.type == int_type());
+  }
+}
+
+TEST_CASE("Mapped goto-binary rejects bad input", "[goto-binary]")
+{
+  contextt ctx;
+  ctx.add(make_symbol("x", ""));
+  std::string data = write(ctx);
+
+  goto_binary_indext index;
+  REQUIRE(index.load(data.data(), 2));
+  REQUIRE(index.load(data.data(), 30));
+
+  std::string v1 = data;
+  v1[6] = 1;
+  REQUIRE(index.load(v1.data(), v1.size()));
+}
+
+TEST_CASE(
+  "Mapped goto-binary round-trips through read_bin_goto_object",
+  "[goto-binary]")
+{
+  contextt ctx;
+  ctx.add(make_symbol("a", "f"));
+  ctx.add(make_symbol("b", "g"));
+  std::string data = write(ctx);
+
+  contextt result;
+  namespacet ns(result);
+  migrate_namespace_lookup = &ns;
+
+  goto_functionst functions;
+  std::istringstream in(data);
+  REQUIRE_FALSE(read_bin_goto_object(in, "", result, functions));
+  REQUIRE(result.size() == 2);
+  REQUIRE(result.find_symbol("a")->value.value() == "a");
+  REQUIRE(result.find_symbol("b")->location.get_function() == "g");
+}
+
+TEST_CASE("Mapped goto-binary is read from a file", "[goto-binary]")
+{
+  contextt ctx;
+  ctx.add(make_symbol("a", "f"));
+  std::string data = write(ctx);
+
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+                                 boost::filesystem::unique_path();
+  std::ofstream(path.string(), std::ios::binary) << data;
+
+  contextt result;
+  namespacet ns(result);
+  migrate_namespace_lookup = &ns;
+
+  goto_functionst functions;
+  goto_binary_reader reader;
+  REQUIRE_FALSE(reader.read_goto_binary(path.string(), result, functions));
+  REQUIRE(result.find_symbol("a") != nullptr);
+  boost::filesystem::remove(path);
+
+  REQUIRE(reader.read_goto_binary(path.string(), result, functions));
+}
+
+TEST_CASE(
+  "Mapped goto-binary only decodes the bodies reachable from the entry",
+  "[goto-binary]")
+{
+  contextt result;
+  namespacet ns(result);
+  migrate_namespace_lookup = &ns;
+
+  contextt ctx;
+  goto_functionst functions;
+  add_function("__ESBMC_main", {"c:@F@f"}, ctx, functions);
+  add_function("c:@F@f", {}, ctx, functions);
+  add_function("c:@F@unused", {}, ctx, functions);
+  std::string path = write_file(ctx, functions);
+
+  goto_functionst read;
+  goto_binary_reader reader;
+  reader.set_entry_points({"__ESBMC_main"});
+  REQUIRE_FALSE(reader.read_goto_binaries({path}, result, read));
+  REQUIRE(read.function_map["__ESBMC_main"].body_available);
+  REQUIRE(read.function_map["c:@F@f"].body_available);
+  REQUIRE_FALSE(read.function_map["c:@F@unused"].body_available);
+  boost::filesystem::remove(path);
+}
+
+TEST_CASE(
+  "Linked goto-binaries decode the bodies called from each other",
+  "[goto-binary]")
+{
+  contextt result;
+  namespacet ns(result);
+  migrate_namespace_lookup = &ns;
+
+  // main.goto calls g in lib.goto, which calls back f in main.goto
+  contextt main_ctx;
+  goto_functionst main_functions;
+  add_function("__ESBMC_main", {"c:@F@g"}, main_ctx, main_functions);
+  add_function("c:@F@f", {}, main_ctx, main_functions);
+  std::string main_path = write_file(main_ctx, main_functions);
+
+  contextt lib_ctx;
+  goto_functionst lib_functions;
+  add_function("c:@F@g", {"c:@F@f"}, lib_ctx, lib_functions);
+  std::string lib_path = write_file(lib_ctx, lib_functions);
+
+  goto_functionst read;
+  goto_binary_reader reader;
+  reader.set_entry_points({"__ESBMC_main"});
+  REQUIRE_FALSE(
+    reader.read_goto_binaries({main_path, lib_path}, result, read));
+  REQUIRE(read.function_map["__ESBMC_main"].body_available);
+  REQUIRE(read.function_map["c:@F@g"].body_available);
+  REQUIRE(read.function_map["c:@F@f"].body_available);
+
+  boost::filesystem::remove(main_path);
+  boost::filesystem::remove(lib_path);
+}
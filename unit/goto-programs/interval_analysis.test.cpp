@@ -5,6 +5,7 @@
 
 #include "../testing-utils/goto_factory.h"
 #include <goto-programs/abstract-interpretation/interval_domain.h>
+#include <sstream>
 
 struct test_item
 {
@@ -81,6 +82,33 @@ public:
         run_test<0>(baseline);
       }
 
+      SECTION("Weak Topological Order")
+      {
+        log_status("Weak Topological Order");
+        set_baseline_config();
+        ait<interval_domaint> baseline;
+        baseline.iteration_strategy = ai_baset::iteration_strategyt::WTO;
+        run_test<0>(baseline);
+      }
+
+      SECTION("Function Summaries")
+      {
+        log_status("Function Summaries");
+        set_baseline_config();
+        ait<interval_domaint> baseline;
+        baseline.use_function_summaries = true;
+        run_test<0>(baseline);
+      }
+
+      SECTION("Parallel Functions")
+      {
+        log_status("Parallel Functions");
+        set_baseline_config();
+        ait<interval_domaint> baseline;
+        baseline.fixedpoint_jobs = 4;
+        run_test<0>(baseline);
+      }
+
       // Wrapped Intervals logic (see "Interval Analysis and Machine Arithmetic 2015" paper)
       SECTION("Wrapped Intervals")
       {
@@ -1058,3 +1086,162 @@ TEST_CASE(
 
   T.run_configs();
 }
+
+TEST_CASE("Interval Analysis - Function Summaries", "[ai][interval-analysis]")
+{
+  test_program T;
+  T.code =
+    "int g;\n"
+    "void set(int v) { g = v; }\n"
+    "int main() {\n"
+    "set(1);\n"
+    "int b = g;\n"
+    "set(5);\n"
+    "return b;\n"
+    "}";
+  T.property["5"].push_back({"@F@main@b", 1, true});
+  // The second call leaves the caller's own variables alone
+  T.property["7"].push_back({"@F@main@b", 1, true});
+  T.property["7"].push_back({"@F@main@b", 2, false});
+  T.property["7"].push_back({"@F@main@b", 5, false});
+
+  test_program::set_baseline_config();
+  ait<interval_domaint> interval_analysis;
+  interval_analysis.use_function_summaries = true;
+  T.run_test<0>(interval_analysis, true);
+}
+
+TEST_CASE("Interval Analysis - Parallel Functions", "[ai][interval-analysis]")
+{
+  test_program::set_baseline_config();
+
+  std::string code =
+    "int g;\n"
+    "int inc(int x) { return x + 1; }\n"
+    "int twice(int x) { return inc(inc(x)); }\n"
+    "void set(int v) { g = v; }\n"
+    "int main() {\n"
+    "int a = twice(1);\n"
+    "set(a);\n"
+    "int b = inc(g);\n"
+    "return b;\n"
+    "}";
+  auto P =
+    goto_factory::get_goto_functions(code, goto_factory::Architecture::BIT_32);
+
+  ait<interval_domaint> sequential;
+  sequential(P.functions, P.ns);
+
+  // Without loops there is nothing to widen, so the rounds must end up with
+  // exactly the same states
+  ait<interval_domaint> parallel;
+  parallel.fixedpoint_jobs = 4;
+  parallel(P.functions, P.ns);
+
+  forall_goto_functions (f_it, P.functions)
+  {
+    forall_goto_program_instructions (i_it, f_it->second.body)
+    {
+      CAPTURE(f_it->first, i_it->location_number);
+      CHECK(sequential[i_it].equals(parallel[i_it]));
+    }
+  }
+}
+
+/// The integer interval of the variable ending in `@name` in `d`, nullptr if
+/// it is top
+static std::shared_ptr<interval_domaint::integer_intervalt>
+integer_interval(const interval_domaint &d, const std::string &name)
+{
+  if (!d.intervals)
+    return nullptr;
+  for (const auto &[var, value] : *d.intervals)
+    if (has_suffix(var, "@" + name))
+      return std::get<0>(value);
+  return nullptr;
+}
+
+TEST_CASE(
+  "Interval Analysis - Weak Topological Order",
+  "[ai][interval-analysis]")
+{
+  test_program::set_baseline_config();
+  interval_domaint::enable_interval_arithmetic = true;
+  interval_domaint::widening_extrapolate = true;
+
+  std::string code =
+    "int main() {\n"
+    "int s = 0, i, j = 0;\n"
+    "for (i = 0; i < 10; i++)\n"
+    "  for (j = 0; j < 10; j++)\n"
+    "    s++;\n"
+    "return s;\n"
+    "}";
+  auto P =
+    goto_factory::get_goto_functions(code, goto_factory::Architecture::BIT_32);
+  const goto_programt &body = P.functions.function_map["c:@F@main"].body;
+
+  // The outer loop is a component with the inner loop nested in it
+  wtot wto(body);
+  CHECK(wto.get_heads().size() == 2);
+  unsigned outer = 0, inner = 0;
+  for (const wtot::elementt &e : wto.elements())
+  {
+    if (!e.component)
+      continue;
+    outer++;
+    for (const wtot::elementt &b : e.body)
+      inner += b.component;
+  }
+  CHECK(outer == 1);
+  CHECK(inner == 1);
+
+  ait<interval_domaint> interval_analysis;
+  interval_analysis.iteration_strategy = ai_baset::iteration_strategyt::WTO;
+  interval_analysis(P.functions, P.ns);
+
+  std::ostringstream oss;
+  interval_analysis.output_iterations(oss);
+  CHECK(oss.str().find("c:@F@main: ") != std::string::npos);
+
+  ait<interval_domaint> fifo;
+  fifo(P.functions, P.ns);
+
+  forall_goto_program_instructions (i_it, body)
+  {
+    if (!i_it->is_return())
+      continue;
+
+    const interval_domaint &d = interval_analysis[i_it];
+    REQUIRE(!d.is_bottom());
+
+    // Widening at the loop heads extrapolates the upper bounds, and the
+    // exit condition of the outer loop still bounds i from below
+    auto s = integer_interval(d, "s");
+    auto i = integer_interval(d, "i");
+    auto j = integer_interval(d, "j");
+    REQUIRE(s);
+    REQUIRE(i);
+    REQUIRE(j);
+    CHECK(s->get_lower() == 0);
+    CHECK(!s->upper);
+    CHECK(i->get_lower() == 10);
+    CHECK(!i->upper);
+    CHECK(j->get_lower() == 0);
+    CHECK(!j->upper);
+
+    // The default iteration strategy ends up with the same bounds
+    for (const char *name : {"s", "i", "j"})
+    {
+      CAPTURE(name);
+      auto by_wto = integer_interval(d, name);
+      auto by_fifo = integer_interval(fifo[i_it], name);
+      REQUIRE(by_fifo);
+      CHECK(by_fifo->lower == by_wto->lower);
+      CHECK(by_fifo->upper == by_wto->upper);
+    }
+  }
+
+  // Later tests must not widen by extrapolation
+  test_program::set_baseline_config();
+}
@@ -1,6 +1,7 @@
 #define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
 #include <catch2/catch.hpp>
 #include <irep2/irep2.h>
+#include <irep2/irep2_hashcons.h>
 #include <irep2/irep2_utils.h>
 #include <util/crypto_hash.h>
 
@@ -115,3 +116,123 @@ SCENARIO("irep2 hashing", "[core][irep2]")
     }
   }
 }
+
+SCENARIO("irep2 hash-consing", "[core][irep2]")
+{
+  irep_hashconst table;
+  GIVEN("Expressions constructed in the same way")
+  {
+    expr2tc e1 = add2tc(get_uint_type(32), gen_ulong(1), gen_ulong(2));
+    expr2tc e2 = add2tc(get_uint_type(32), gen_ulong(1), gen_ulong(2));
+    REQUIRE(e1.get() != e2.get());
+
+    THEN("Interning them yields the same node")
+    {
+      const expr2tc i1 = table.intern(e1);
+      const expr2tc i2 = table.intern(e2);
+      REQUIRE(i1 == e1);
+      REQUIRE(i1.get() == i2.get());
+      REQUIRE(to_add2t(i1).side_1.get() == table.intern(gen_ulong(1)).get());
+    }
+    THEN("Interned nodes are not modified in place")
+    {
+      const expr2tc i1 = table.intern(e1);
+      expr2tc copy = i1;
+      to_add2t(copy).side_1 = gen_ulong(3);
+      REQUIRE(copy.get() != i1.get());
+      REQUIRE(table.intern(e2) == e1);
+    }
+  }
+  table.clear();
+  REQUIRE(table.size() == 0);
+
+  GIVEN("A table made current for this thread")
+  {
+    expr2tc e = add2tc(get_uint_type(32), gen_ulong(1), gen_ulong(2));
+    THEN("Only its scope interns into it")
+    {
+      REQUIRE(irep_hashconst::maybe_intern(e).get() == e.get());
+      {
+        irep_hashcons_scopet scope;
+        const expr2tc i = irep_hashconst::maybe_intern(e);
+        REQUIRE(scope.get().size() != 0);
+        REQUIRE(
+          irep_hashconst::maybe_intern(
+            add2tc(get_uint_type(32), gen_ulong(1), gen_ulong(2)))
+            .get() == i.get());
+      }
+      REQUIRE(irep_hashconst::maybe_intern(e).get() == e.get());
+    }
+  }
+}
+
+SCENARIO("irep2 arena allocation", "[core][irep2]")
+{
+  // Built outside of any arena, like the cached types
+  const type2tc t = get_uint_type(32);
+  const expr2tc one = gen_ulong(1);
+  const expr2tc two = gen_ulong(2);
+  const size_t live = irep_arenat::live_arenas();
+
+  GIVEN("Expressions built inside an arena scope")
+  {
+    expr2tc escaped;
+    {
+      irep_arena_scopet scope;
+      expr2tc e = add2tc(t, one, two);
+      REQUIRE(scope.allocated_bytes() > 0);
+      escaped = e;
+    }
+
+    THEN("They outlive the scope and keep its arena alive")
+    {
+      REQUIRE(irep_arenat::live_arenas() == live + 1);
+      REQUIRE(escaped == add2tc(t, one, two));
+      escaped.reset();
+      REQUIRE(irep_arenat::live_arenas() == live);
+    }
+  }
+
+  GIVEN("Expressions that don't escape their arena scope")
+  {
+    {
+      irep_arena_scopet scope;
+      expr2tc e = add2tc(t, one, two);
+      REQUIRE(irep_arenat::live_arenas() == live + 1);
+    }
+
+    THEN("The arena is released with the scope")
+    {
+      REQUIRE(irep_arenat::live_arenas() == live);
+    }
+  }
+
+  GIVEN("An expression referring to nodes of a nested arena")
+  {
+    expr2tc outer_expr;
+    {
+      irep_arena_scopet outer;
+      expr2tc inner_expr;
+      size_t outer_bytes = outer.allocated_bytes();
+      {
+        irep_arena_scopet inner;
+        inner_expr = add2tc(t, one, two);
+        REQUIRE(inner.allocated_bytes() > 0);
+        REQUIRE(outer.allocated_bytes() == outer_bytes);
+      }
+
+      // Allocation goes back to the outer arena once the inner scope ended
+      outer_expr = mul2tc(t, inner_expr, two);
+      REQUIRE(outer.allocated_bytes() > outer_bytes);
+      REQUIRE(irep_arenat::live_arenas() == live + 2);
+    }
+
+    THEN("The nested arena lives as long as the expression referring to it")
+    {
+      REQUIRE(irep_arenat::live_arenas() == live + 2);
+      REQUIRE(outer_expr == mul2tc(t, add2tc(t, one, two), two));
+      outer_expr.reset();
+      REQUIRE(irep_arenat::live_arenas() == live);
+    }
+  }
+}
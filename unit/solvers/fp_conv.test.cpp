@@ -0,0 +1,156 @@
+/// \file Tests for the bit-blasted floating-point encoding
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+#include <memory>
+#include <solvers/solve.h>
+#include <string>
+#include <util/config.h>
+#include <util/context.h>
+#include <util/message.h>
+#include <vector>
+
+namespace
+{
+std::unique_ptr<smt_convt>
+make_solver(const namespacet &ns, const optionst &options)
+{
+  config.ansi_c.set_data_model(configt::LP64);
+  return std::unique_ptr<smt_convt>(create_solver("", ns, options));
+}
+
+smt_astt mk_float(fp_convt &fp, float f)
+{
+  ieee_floatt value(ieee_float_spect::single_precision());
+  value.from_float(f);
+  return fp.mk_smt_fpbv(value);
+}
+
+/// Sums every product x_i * x_j of n operands, as in a matrix product:
+/// each operand is used n times, so its unpacking and classification are
+/// shared. Without `share`, every operation gets a fresh fp_convt and so
+/// builds all of its circuits again, as before they were cached.
+smt_astt pairwise_products(smt_convt *solver, unsigned n, bool share)
+{
+  fp_convt shared(solver);
+  smt_sortt sort = shared.mk_fpbv_sort(8, 23);
+  smt_astt rm = shared.mk_smt_fpbv_rm(ieee_floatt::ROUND_TO_EVEN);
+  std::vector<smt_astt> xs;
+  for (unsigned i = 0; i < n; i++)
+    xs.push_back(solver->mk_smt_symbol("x" + std::to_string(i), sort));
+
+  smt_astt sum = xs[0];
+  for (unsigned i = 0; i < n; i++)
+    for (unsigned j = 0; j < n; j++)
+    {
+      smt_astt mul = share ? shared.mk_smt_fpbv_mul(xs[i], xs[j], rm)
+                           : fp_convt(solver).mk_smt_fpbv_mul(xs[i], xs[j], rm);
+      sum = share ? shared.mk_smt_fpbv_add(sum, mul, rm)
+                  : fp_convt(solver).mk_smt_fpbv_add(sum, mul, rm);
+    }
+  return sum;
+}
+} // namespace
+
+SCENARIO("fp_convt shares circuits between identical operations", "[solvers]")
+{
+  contextt context;
+  namespacet ns(context);
+  optionst options;
+  options.set_option("fp2bv", true);
+
+  std::unique_ptr<smt_convt> solver = make_solver(ns, options);
+  fp_convt fp(solver.get());
+  smt_sortt sort = fp.mk_fpbv_sort(8, 23);
+  smt_astt x = solver->mk_smt_symbol("x", sort);
+  smt_astt y = solver->mk_smt_symbol("y", sort);
+  smt_astt rm = fp.mk_smt_fpbv_rm(ieee_floatt::ROUND_TO_EVEN);
+
+  GIVEN("The same operation on the same operands")
+  {
+    THEN("The circuit is built once")
+    {
+      smt_astt mul = fp.mk_smt_fpbv_mul(x, y, rm);
+      REQUIRE(fp.mk_smt_fpbv_mul(x, y, rm) == mul);
+      REQUIRE(fp.mk_smt_fpbv_is_nan(x) == fp.mk_smt_fpbv_is_nan(x));
+    }
+
+    THEN("Different operands or operations get their own circuit")
+    {
+      smt_astt mul = fp.mk_smt_fpbv_mul(x, y, rm);
+      REQUIRE(fp.mk_smt_fpbv_mul(y, x, rm) != mul);
+      REQUIRE(fp.mk_smt_fpbv_div(x, y, rm) != mul);
+      REQUIRE(fp.mk_smt_fpbv_is_nan(x) != fp.mk_smt_fpbv_is_nan(y));
+    }
+
+    THEN("Circuits built in a popped context are forgotten")
+    {
+      smt_astt mul = fp.mk_smt_fpbv_mul(x, y, rm);
+      const size_t outer = fp.shared_circuits();
+
+      fp.push_fp_ctx();
+      smt_astt add = fp.mk_smt_fpbv_add(x, y, rm);
+      REQUIRE(fp.mk_smt_fpbv_add(x, y, rm) == add);
+      REQUIRE(fp.shared_circuits() > outer);
+      fp.pop_fp_ctx();
+
+      // The sum's circuit is dropped, the product's built before is kept
+      REQUIRE(fp.shared_circuits() == outer);
+      REQUIRE(fp.mk_smt_fpbv_mul(x, y, rm) == mul);
+    }
+  }
+
+  GIVEN("Operations sharing the unpacking of their operands")
+  {
+    // x * x + x with x = 3 is 12
+    smt_astt square = fp.mk_smt_fpbv_mul(x, x, rm);
+    smt_astt sum = fp.mk_smt_fpbv_add(square, x, rm);
+
+    THEN("They are still exact")
+    {
+      solver->assert_ast(solver->mk_eq(x, mk_float(fp, 3.0f)));
+      solver->assert_ast(
+        solver->mk_not(solver->mk_eq(sum, mk_float(fp, 12.0f))));
+      REQUIRE(solver->dec_solve() == smt_convt::P_UNSATISFIABLE);
+    }
+  }
+}
+
+// Hidden by default, run with `fpconvtest "[benchmark]"`
+TEST_CASE("fp_convt products of shared operands", "[.][benchmark][solvers]")
+{
+  contextt context;
+  namespacet ns(context);
+  optionst options;
+  options.set_option("fp2bv", true);
+
+  for (unsigned n : {8u, 16u, 32u})
+  {
+    // Formula size, as the number of ASTs built
+    size_t asts[2];
+    for (bool share : {false, true})
+    {
+      std::unique_ptr<smt_convt> solver = make_solver(ns, options);
+      size_t before = solver->live_asts.size();
+      pairwise_products(solver.get(), n, share);
+      asts[share] = solver->live_asts.size() - before;
+    }
+    log_status(
+      "pairwise products of {}: {} ASTs without sharing, {} with sharing",
+      n,
+      asts[false],
+      asts[true]);
+    CHECK(asts[true] < asts[false]);
+
+    BENCHMARK_ADVANCED("pairwise products of " + std::to_string(n))
+    (Catch::Benchmark::Chronometer meter)
+    {
+      std::vector<std::unique_ptr<smt_convt>> solvers;
+      for (int i = 0; i < meter.runs(); i++)
+        solvers.push_back(make_solver(ns, options));
+      meter.measure(
+        [&](int r) { return pairwise_products(solvers[r].get(), n, true); });
+    };
+  }
+}
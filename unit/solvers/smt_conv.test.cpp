@@ -0,0 +1,178 @@
+/// \file Tests for the conversion of expressions into the SMT solver
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <future>
+#include <irep2/irep2_utils.h>
+#include <memory>
+#include <solvers/solve.h>
+#include <string>
+#include <util/c_types.h>
+#include <util/config.h>
+#include <util/context.h>
+#include <vector>
+
+namespace
+{
+/// The value of `x` after `n` branches that may increment it, in the shape
+/// phi functions leave it: x_{i+1} = c_i ? x_i + 1 : x_i. Every level is
+/// kept, so that the chain can be freed from the top without recursing.
+std::vector<expr2tc> phi_chain(size_t n)
+{
+  const type2tc t = get_uint_type(32);
+  std::vector<expr2tc> levels = {symbol2tc(t, "x")};
+  levels.reserve(n + 1);
+  for (size_t i = 0; i < n; i++)
+  {
+    const expr2tc &x = levels.back();
+    expr2tc c = symbol2tc(get_bool_type(), "c" + std::to_string(i));
+    levels.push_back(if2tc(t, c, add2tc(t, x, gen_one(t)), x));
+    // Hash each level while its operands are hashed, as symex does
+    levels.back()->crc();
+  }
+  return levels;
+}
+
+void free_chain(std::vector<expr2tc> &levels)
+{
+  while (!levels.empty())
+    levels.pop_back();
+}
+
+std::unique_ptr<smt_convt>
+make_solver(const namespacet &ns, const optionst &options)
+{
+  config.ansi_c.set_data_model(configt::LP64);
+  return std::unique_ptr<smt_convt>(create_solver("", ns, options));
+}
+} // namespace
+
+SCENARIO("convert_ast converts deep expressions", "[solvers]")
+{
+  contextt context;
+  namespacet ns(context);
+  optionst options;
+
+  GIVEN("A short chain of if-then-else expressions")
+  {
+    std::unique_ptr<smt_convt> solver = make_solver(ns, options);
+    std::vector<expr2tc> chain = phi_chain(3);
+    const type2tc t = chain.back()->type;
+
+    THEN("Taking every branch from zero gives three")
+    {
+      solver->assert_expr(equality2tc(symbol2tc(t, "x"), gen_zero(t)));
+      for (unsigned i = 0; i < 3; i++)
+        solver->assert_expr(
+          symbol2tc(get_bool_type(), "c" + std::to_string(i)));
+      solver->assert_expr(
+        notequal2tc(chain.back(), constant_int2tc(t, BigInt(3))));
+      REQUIRE(solver->dec_solve() == smt_convt::P_UNSATISFIABLE);
+    }
+    free_chain(chain);
+  }
+
+  GIVEN("A chain deeper than the native stack could recurse over")
+  {
+    std::unique_ptr<smt_convt> solver = make_solver(ns, options);
+    std::vector<expr2tc> chain = phi_chain(200000);
+
+    THEN("It is converted once and then found in the cache")
+    {
+      smt_astt a = solver->convert_ast(chain.back());
+      REQUIRE(a != nullptr);
+      REQUIRE(solver->convert_ast(chain.back()) == a);
+      REQUIRE(solver->convert_ast(chain[chain.size() / 2]) != nullptr);
+    }
+    free_chain(chain);
+  }
+}
+
+SCENARIO("A running solver can be interrupted", "[solvers]")
+{
+  contextt context;
+  namespacet ns(context);
+  optionst options;
+  std::unique_ptr<smt_convt> solver = make_solver(ns, options);
+  if (!solver->can_interrupt())
+    return;
+
+  GIVEN("A formula too hard to answer quickly")
+  {
+    // Factoring the product of two 32-bit primes by bit-blasting
+    smt_sortt sort = solver->mk_bv_sort(128);
+    smt_astt x = solver->mk_zero_ext(
+      solver->mk_smt_symbol("x", solver->mk_bv_sort(64)), 64);
+    smt_astt y = solver->mk_zero_ext(
+      solver->mk_smt_symbol("y", solver->mk_bv_sort(64)), 64);
+    smt_astt one = solver->mk_smt_bv(BigInt(1), sort);
+    solver->assert_ast(solver->mk_bvugt(x, one));
+    solver->assert_ast(solver->mk_bvugt(y, one));
+    solver->assert_ast(solver->mk_eq(
+      solver->mk_bvmul(x, y),
+      solver->mk_smt_bv(BigInt("18446743979220271189"), sort)));
+
+    THEN("dec_solve() gives up once asked to")
+    {
+      std::future<smt_convt::resultt> result =
+        std::async(std::launch::async, [&]() { return solver->dec_solve(); });
+      // The request is missed until the search starts, so repeat it
+      while (result.wait_for(std::chrono::milliseconds(50)) !=
+             std::future_status::ready)
+        solver->interrupt();
+      REQUIRE(result.get() == smt_convt::P_ERROR);
+    }
+  }
+}
+
+// Hidden by default, run with `smtconvtest "[benchmark]"`
+TEST_CASE("convert_ast throughput", "[.][benchmark][solvers]")
+{
+  contextt context;
+  namespacet ns(context);
+  optionst options;
+
+  for (size_t depth : {1000u, 10000u, 100000u})
+  {
+    std::vector<expr2tc> chain = phi_chain(depth);
+
+    BENCHMARK_ADVANCED("phi chain, depth " + std::to_string(depth))
+    (Catch::Benchmark::Chronometer meter)
+    {
+      // A fresh solver per run, so that nothing comes from the cache
+      std::vector<std::unique_ptr<smt_convt>> solvers;
+      for (int i = 0; i < meter.runs(); i++)
+        solvers.push_back(make_solver(ns, options));
+      meter.measure(
+        [&](int i) { return solvers[i]->convert_ast(chain.back()); });
+    };
+
+    // Many shallow, independent assignments, as in straight-line code
+    std::vector<expr2tc> assigns;
+    const type2tc t = get_uint_type(32);
+    for (size_t i = 0; i < depth; i++)
+    {
+      const std::string n = std::to_string(i);
+      assigns.push_back(equality2tc(
+        symbol2tc(t, "y" + n),
+        mul2tc(t, add2tc(t, symbol2tc(t, "a" + n), gen_one(t)), gen_one(t))));
+    }
+
+    BENCHMARK_ADVANCED("assignments, " + std::to_string(depth))
+    (Catch::Benchmark::Chronometer meter)
+    {
+      std::vector<std::unique_ptr<smt_convt>> solvers;
+      for (int i = 0; i < meter.runs(); i++)
+        solvers.push_back(make_solver(ns, options));
+      meter.measure([&](int i) {
+        for (const expr2tc &e : assigns)
+          solvers[i]->convert_ast(e);
+        return solvers[i].get();
+      });
+    };
+
+    free_chain(chain);
+  }
+}
@@ -0,0 +1,114 @@
+/// \file Tests for the claim result cache, see --claim-result-cache
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <irep2/irep2_utils.h>
+#include <util/c_types.h>
+#include <util/cache.h>
+#include <util/context.h>
+#include <util/namespace.h>
+
+namespace
+{
+/// An equation asserting x != `value`
+void claim(symex_target_equationt &eq, unsigned value)
+{
+  const type2tc t = get_uint_type(32);
+  eq.SSA_steps.clear();
+  symex_target_equationt::SSA_stept &step = eq.SSA_steps.emplace_back();
+  step.type = goto_trace_stept::ASSERT;
+  step.guard = gen_true_expr();
+  step.cond = notequal2tc(symbol2tc(t, "x"), constant_int2tc(t, value));
+}
+} // namespace
+
+SCENARIO("claim_result_cachet keeps proven claims", "[core][utils]")
+{
+  contextt context;
+  namespacet ns(context);
+  symex_target_equationt eq(ns);
+  claim(eq, 6);
+
+  const std::string path = (boost::filesystem::temp_directory_path() /
+                            boost::filesystem::unique_path())
+                             .string();
+
+  GIVEN("A claim proven and saved by an earlier run")
+  {
+    {
+      claim_result_cachet cache(path, "salt");
+      REQUIRE(cache.size() == 0);
+      REQUIRE_FALSE(cache.is_proven(cache.key(eq)));
+      cache.record_proven(cache.key(eq));
+      cache.save();
+    }
+
+    THEN("It is proven when the cache is loaded again")
+    {
+      claim_result_cachet cache(path, "salt");
+      REQUIRE(cache.size() == 1);
+      REQUIRE(cache.is_proven(cache.key(eq)));
+    }
+
+    THEN("It isn't with another salt, e.g. another solver")
+    {
+      claim_result_cachet cache(path, "other salt");
+      REQUIRE_FALSE(cache.is_proven(cache.key(eq)));
+    }
+
+    THEN("Another formula isn't")
+    {
+      claim_result_cachet cache(path, "salt");
+      claim(eq, 8);
+      REQUIRE_FALSE(cache.is_proven(cache.key(eq)));
+    }
+
+    THEN("Steps ignored by slicing don't change the key")
+    {
+      claim_result_cachet cache(path, "salt");
+      symex_target_equationt::SSA_stept &extra = eq.SSA_steps.emplace_back();
+      extra.type = goto_trace_stept::ASSUME;
+      extra.guard = gen_true_expr();
+      extra.cond = gen_false_expr();
+      extra.ignore = true;
+      REQUIRE(cache.is_proven(cache.key(eq)));
+    }
+
+    THEN("Saving again only appends what is new")
+    {
+      {
+        claim_result_cachet cache(path, "salt");
+        cache.record_proven(cache.key(eq));
+        claim(eq, 8);
+        cache.record_proven(cache.key(eq));
+        cache.save();
+      }
+      claim_result_cachet cache(path, "salt");
+      REQUIRE(cache.size() == 2);
+    }
+  }
+
+  GIVEN("A file in an unknown format")
+  {
+    std::ofstream(path) << "not a cache\n";
+
+    THEN("It is neither used nor overwritten")
+    {
+      {
+        claim_result_cachet cache(path, "salt");
+        REQUIRE(cache.size() == 0);
+        cache.record_proven(cache.key(eq));
+        cache.save();
+      }
+      std::ifstream in(path);
+      std::string line;
+      REQUIRE(std::getline(in, line));
+      REQUIRE(line == "not a cache");
+      REQUIRE_FALSE(std::getline(in, line));
+    }
+  }
+
+  boost::filesystem::remove(path);
+}
@@ -0,0 +1,150 @@
+/// \file Tests for the structurally shared map used by symex states
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <util/persistent_map.h>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+
+namespace
+{
+// Sends every key to the same few buckets, to exercise deep tries and
+// leaves holding several entries
+struct bad_hash
+{
+  size_t operator()(unsigned k) const
+  {
+    return k % 3 == 0 ? 42 : (k % 7) << 20;
+  }
+};
+
+template <typename Map, typename Ref>
+void require_same(const Map &map, const Ref &ref)
+{
+  REQUIRE(map.size() == ref.size());
+  size_t seen = 0;
+  for (const auto &[k, v] : map)
+  {
+    auto it = ref.find(k);
+    REQUIRE(it != ref.end());
+    REQUIRE(it->second == v);
+    ++seen;
+  }
+  REQUIRE(seen == ref.size());
+  for (const auto &[k, v] : ref)
+  {
+    REQUIRE(map.find(k) != map.end());
+    REQUIRE(map.find(k)->second == v);
+  }
+}
+} // namespace
+
+SCENARIO("persistent_map behaves like a map", "[core][utils][persistent_map]")
+{
+  GIVEN("An empty map")
+  {
+    persistent_mapt<std::string, int> map;
+
+    THEN("Nothing can be found")
+    {
+      REQUIRE(map.empty());
+      REQUIRE(map.begin() == map.end());
+      REQUIRE(map.find("a") == map.end());
+      REQUIRE(map.find_writable("a") == nullptr);
+      REQUIRE(map.erase("a") == 0);
+    }
+
+    THEN("Inserted entries are found and only inserted once")
+    {
+      REQUIRE(map.insert("a", 1).second);
+      REQUIRE(!map.insert("a", 2).second);
+      map["b"] = 3;
+      REQUIRE(map.size() == 2);
+      REQUIRE(map.find("a")->second == 1);
+      REQUIRE(map.count("b") == 1);
+      *map.find_writable("b") += 1;
+      REQUIRE(map.find("b")->second == 4);
+    }
+  }
+
+  GIVEN("Random operations mirrored in a std::map")
+  {
+    std::mt19937 rng(1234);
+    persistent_mapt<unsigned, unsigned, bad_hash> map;
+    std::map<unsigned, unsigned> ref;
+
+    for (unsigned i = 0; i < 5000; i++)
+    {
+      unsigned k = rng() % 400;
+      if (rng() % 3 == 0)
+        REQUIRE(map.erase(k) == ref.erase(k));
+      else
+        map[k] = ref[k] = i;
+    }
+
+    THEN("Both hold the same entries")
+    {
+      require_same(map, ref);
+    }
+
+    THEN("Erasing everything leaves an empty map")
+    {
+      for (const auto &[k, v] : ref)
+        REQUIRE(map.erase(k) == 1);
+      REQUIRE(map.empty());
+      REQUIRE(map.begin() == map.end());
+    }
+  }
+}
+
+SCENARIO(
+  "persistent_map copies share structure",
+  "[core][utils][persistent_map]")
+{
+  GIVEN("A map and a copy of it")
+  {
+    persistent_mapt<unsigned, unsigned> map;
+    std::map<unsigned, unsigned> ref;
+    for (unsigned i = 0; i < 10000; i++)
+      map[i] = ref[i] = i;
+
+    persistent_mapt<unsigned, unsigned> copy = map;
+
+    THEN("Changing the copy leaves the original alone")
+    {
+      copy[5] = 42;
+      copy.erase(6);
+      copy[20000] = 1;
+      require_same(map, ref);
+
+      REQUIRE(copy.find(5)->second == 42);
+      REQUIRE(copy.find(6) == copy.end());
+      REQUIRE(copy.size() == map.size());
+    }
+
+    THEN("Only the changed entries are unshared")
+    {
+      copy[5] = 42;
+      copy.erase(6);
+      copy[20000] = 1;
+
+      std::set<unsigned> unshared;
+      copy.for_each_unshared(
+        map, [&unshared](const auto &e) { unshared.insert(e.first); });
+
+      REQUIRE(unshared.count(5) == 1);
+      REQUIRE(unshared.count(20000) == 1);
+      REQUIRE(unshared.count(6) == 0);
+      REQUIRE(unshared.size() < 100);
+    }
+
+    THEN("An untouched copy shares everything")
+    {
+      size_t n = 0;
+      copy.for_each_unshared(map, [&n](const auto &) { ++n; });
+      REQUIRE(n == 0);
+    }
+  }
+}
@@ -0,0 +1,154 @@
+/// \file Tests for the sharded string pool behind dstring
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+#include <util/string_container.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+std::vector<std::string> make_names(const std::string &prefix, size_t n)
+{
+  std::vector<std::string> names;
+  names.reserve(n);
+  for (size_t i = 0; i < n; i++)
+    names.push_back(prefix + std::to_string(i));
+  return names;
+}
+
+/// Every thread interns the whole of `names`, in a rotated order so that
+/// threads race on the same strings
+void intern_all(
+  string_containert &pool,
+  const std::vector<std::string> &names,
+  unsigned n_threads,
+  std::vector<std::vector<unsigned>> &ids)
+{
+  ids.assign(n_threads, std::vector<unsigned>(names.size()));
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < n_threads; t++)
+    threads.emplace_back([&, t]() {
+      size_t offset = t * names.size() / n_threads;
+      for (size_t i = 0; i < names.size(); i++)
+      {
+        size_t idx = (i + offset) % names.size();
+        ids[t][idx] = pool[names[idx]];
+      }
+    });
+
+  for (auto &thread : threads)
+    thread.join();
+}
+} // namespace
+
+SCENARIO("string_container interning", "[core][utils][string_container]")
+{
+  GIVEN("A fresh string container")
+  {
+    string_containert pool;
+
+    THEN("The empty string has id 0")
+    {
+      REQUIRE(pool[""] == 0);
+      REQUIRE(pool.get_string(0).empty());
+      REQUIRE(pool.size() == 1);
+    }
+
+    THEN("Equal strings get equal ids and ids map back to the string")
+    {
+      unsigned a = pool["foo"];
+      unsigned b = pool[std::string("bar")];
+      REQUIRE(a != b);
+      REQUIRE(pool[std::string("foo")] == a);
+      REQUIRE(pool["bar"] == b);
+      REQUIRE(pool.get_string(a) == "foo");
+      REQUIRE(std::string(pool.c_str(b)) == "bar");
+    }
+
+    THEN("Strings with embedded prefixes are kept apart")
+    {
+      REQUIRE(pool["abc"] != pool["ab"]);
+      REQUIRE(pool["ab"] != pool["a"]);
+    }
+
+    THEN("Ids stay dense when the table grows past one segment")
+    {
+      auto names = make_names("seg_", 70000);
+      std::vector<unsigned> ids;
+      for (const auto &n : names)
+        ids.push_back(pool[n]);
+
+      REQUIRE(pool.size() == names.size() + 1);
+      for (size_t i = 0; i < names.size(); i++)
+        REQUIRE(pool.get_string(ids[i]) == names[i]);
+    }
+  }
+
+  GIVEN("Several threads interning the same strings")
+  {
+    string_containert pool;
+    auto names = make_names("sym_", 20000);
+    std::vector<std::vector<unsigned>> ids;
+    intern_all(pool, names, 8, ids);
+
+    THEN("All threads agree on every id")
+    {
+      for (size_t t = 1; t < ids.size(); t++)
+        REQUIRE(ids[t] == ids[0]);
+    }
+
+    THEN("Every string was interned exactly once")
+    {
+      REQUIRE(pool.size() == names.size() + 1);
+      for (size_t i = 0; i < names.size(); i++)
+        REQUIRE(pool.get_string(ids[0][i]) == names[i]);
+    }
+  }
+}
+
+// Hidden by default, run with `stringcontainertest "[benchmark]"`
+TEST_CASE("string_container scaling", "[.][benchmark][string_container]")
+{
+  auto names = make_names("c:@F@main@x_", 1 << 16);
+
+  for (unsigned n_threads : {1u, 2u, 4u, 8u, 16u, 32u, 64u})
+  {
+    BENCHMARK_ADVANCED("intern, " + std::to_string(n_threads) + " threads")
+    (Catch::Benchmark::Chronometer meter)
+    {
+      meter.measure([&]() {
+        string_containert pool;
+        std::vector<std::vector<unsigned>> ids;
+        intern_all(pool, names, n_threads, ids);
+        return pool.size();
+      });
+    };
+
+    BENCHMARK_ADVANCED("lookup, " + std::to_string(n_threads) + " threads")
+    (Catch::Benchmark::Chronometer meter)
+    {
+      string_containert pool;
+      std::vector<unsigned> ids;
+      for (const auto &n : names)
+        ids.push_back(pool[n]);
+
+      meter.measure([&]() {
+        std::vector<std::thread> threads;
+        std::atomic<size_t> total{0};
+        for (unsigned t = 0; t < n_threads; t++)
+          threads.emplace_back([&]() {
+            size_t len = 0;
+            for (unsigned id : ids)
+              len += pool.get_string(id).size();
+            total += len;
+          });
+        for (auto &thread : threads)
+          thread.join();
+        return total.load();
+      });
+    };
+  }
+}